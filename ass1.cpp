@@ -1,18 +1,805 @@
 #include <iostream>
 #include <vector>
 #include <unordered_map>
-#include <set>
 #include <queue>
 #include <stack>
 #include <functional>
 #include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <atomic>
+#include <random>
+#include "search.hpp"
 
 using namespace std;
 
+// Immutable CSR snapshot of a Graph with vertices renumbered 0 .. n-1: the
+// neighbours of v are targets[offsets[v]] .. targets[offsets[v + 1] - 1].
+// ids maps a dense index back to the vertex id used in the Graph, index maps the
+// other way.
+struct CompactGraph {
+    int n = 0;
+    vector<int> offsets{0};
+    vector<int> targets;
+    vector<int> ids;
+    unordered_map<int, int> index;
+
+    int degree(int v) const {
+        return offsets[v + 1] - offsets[v];
+    }
+
+    // Levels from one source by plain queue BFS, -1 where unreachable.
+    vector<int> bfsLevels(int source) const {
+        vector<int> level(n, -1);
+        vector<int> queue;
+        queue.reserve(n);
+        level[source] = 0;
+        queue.push_back(source);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int v = queue[head];
+            for (int e = offsets[v]; e < offsets[v + 1]; ++e) {
+                int u = targets[e];
+                if (level[u] == -1) {
+                    level[u] = level[v] + 1;
+                    queue.push_back(u);
+                }
+            }
+        }
+        return level;
+    }
+
+    // Iterative DFS preorder from source, neighbours tried in stored order.
+    vector<int> dfsPreorder(int source) const {
+        vector<int> order;
+        vector<char> visited(n, 0);
+        vector<int> stack{source};
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            if (visited[v]) continue;
+            visited[v] = 1;
+            order.push_back(v);
+            for (int e = offsets[v + 1] - 1; e >= offsets[v]; --e)
+                if (!visited[targets[e]]) stack.push_back(targets[e]);
+        }
+        return order;
+    }
+
+    // Mean |v - u| over all arcs; lower means neighbours sit closer in memory.
+    double averageGap() const {
+        if (targets.empty()) return 0;
+        double total = 0;
+        for (int v = 0; v < n; ++v)
+            for (int e = offsets[v]; e < offsets[v + 1]; ++e) total += abs(v - targets[e]);
+        return total / targets.size();
+    }
+};
+
+// Read-only adjacency packed as varints. Each neighbour list is sorted; the
+// first entry is stored as a zigzag-encoded delta from the vertex itself and the
+// rest as gaps from the previous neighbour, seven bits per byte with the high
+// bit marking continuation. v's list starts at blockBase[v / BLOCK] + offsets[v],
+// so the per-vertex index costs four bytes like a CSR offset while the stream
+// itself may exceed 4 GB, and any list can be decoded independently. Small gaps
+// (after a locality-improving reordering) mostly take one byte instead of four.
+class CompressedGraph {
+private:
+    static const int BLOCK = 1024;
+
+    vector<uint8_t> data;
+    vector<uint64_t> blockBase;
+    vector<uint32_t> offsets;
+    // Empty while ids is sorted; for a relabelled graph, the indices in id order.
+    vector<int> byId;
+
+    const uint8_t* listStart(int v) const {
+        return data.data() + blockBase[v / BLOCK] + offsets[v];
+    }
+
+    static void putVarint(vector<uint8_t>& out, uint64_t x) {
+        while (x >= 0x80) {
+            out.push_back((uint8_t)(x | 0x80));
+            x >>= 7;
+        }
+        out.push_back((uint8_t)x);
+    }
+
+    // Unrolled for the one- to three-byte gaps that make up nearly every list.
+    static uint64_t getVarint(const uint8_t*& p) {
+        uint64_t x = p[0];
+        if (x < 0x80) {
+            p += 1;
+            return x;
+        }
+        x = (x & 0x7f) | (uint64_t)(p[1] & 0x7f) << 7;
+        if (p[1] < 0x80) {
+            p += 2;
+            return x;
+        }
+        x |= (uint64_t)(p[2] & 0x7f) << 14;
+        if (p[2] < 0x80) {
+            p += 3;
+            return x;
+        }
+        p += 3;
+        for (int shift = 21;; shift += 7) {
+            uint64_t b = *p++;
+            x |= (b & 0x7f) << shift;
+            if (b < 0x80) return x;
+        }
+    }
+
+    // Appends v's sorted neighbour list; vertices arrive in order 0 .. n-1 and
+    // finish() closes the stream.
+    void appendList(int v, const int* list, size_t count) {
+        if (v % BLOCK == 0) blockBase.push_back(data.size());
+        offsets[v] = data.size() - blockBase[v / BLOCK];
+        for (size_t i = 0; i < count; ++i) {
+            if (i == 0) {
+                long long delta = (long long)list[0] - v;
+                putVarint(data, delta >= 0 ? (uint64_t)delta << 1 : ((uint64_t)(-delta) << 1) - 1);
+            } else {
+                putVarint(data, (uint64_t)(list[i] - list[i - 1]));
+            }
+        }
+    }
+
+    void finish() {
+        if (n % BLOCK == 0) blockBase.push_back(data.size());
+        offsets[n] = data.size() - blockBase[n / BLOCK];
+        data.shrink_to_fit();
+    }
+
+    // Calls fn(u, v) for each "u v" line of an edge-list file, skipping blank
+    // lines and # or % comments. False, with error set, if the file cannot be
+    // read, a line is malformed or longer than the buffer, or fn returns false.
+    template <typename Fn>
+    static bool forEachEdge(const string& path, Fn fn, string& error) {
+        FILE* f = fopen(path.c_str(), "r");
+        if (!f) {
+            error = "cannot open " + path;
+            return false;
+        }
+        char line[256];
+        long long lineNo = 0;
+        bool ok = true;
+        while (fgets(line, sizeof(line), f)) {
+            lineNo++;
+            if (!strchr(line, '\n') && !feof(f)) {
+                error = "line " + to_string(lineNo) + ": longer than " + to_string(sizeof(line) - 2) + " characters";
+                ok = false;
+                break;
+            }
+            const char* p = line;
+            while (*p == ' ' || *p == '\t') p++;
+            if (*p == '\n' || *p == '\r' || *p == '#' || *p == '%' || *p == '\0') continue;
+            int u, v;
+            if (sscanf(p, "%d %d", &u, &v) != 2) {
+                error = "line " + to_string(lineNo) + ": expected '<u> <v>'";
+                ok = false;
+                break;
+            }
+            if (!fn(u, v)) {
+                ok = false;
+                break;
+            }
+        }
+        if (ok && ferror(f)) {
+            error = "cannot read " + path;
+            ok = false;
+        }
+        fclose(f);
+        return ok;
+    }
+
+public:
+    int n = 0;
+    long long arcs = 0;
+    vector<int> ids;
+
+    CompressedGraph() = default;
+
+    explicit CompressedGraph(const CompactGraph& g) : offsets(g.n + 1, 0), n(g.n), arcs(g.targets.size()),
+                                                      ids(g.ids) {
+        if (!is_sorted(ids.begin(), ids.end())) {
+            byId.resize(n);
+            for (int i = 0; i < n; ++i) byId[i] = i;
+            sort(byId.begin(), byId.end(), [&](int a, int b) { return ids[a] < ids[b]; });
+        }
+        data.reserve(g.targets.size() + g.n);
+        vector<int> list;
+        for (int v = 0; v < g.n; ++v) {
+            list.assign(g.targets.begin() + g.offsets[v], g.targets.begin() + g.offsets[v + 1]);
+            sort(list.begin(), list.end());
+            appendList(v, list.data(), list.size());
+        }
+        finish();
+    }
+
+    // Builds straight from an undirected edge-list file without ever holding the
+    // uncompressed adjacency. One pass collects the vertex ids and degrees; then
+    // vertices are taken in blocks whose arcs fit in memoryBytes, and each block
+    // costs one more pass that gathers only that block's arcs, sorts and encodes
+    // them. Peak memory is the compressed graph with its sorted ids plus one
+    // block of arcs. Vertices come out in ascending id order with sorted lists, the
+    // same graph CompressedGraph(g.compact()) gives for g built from the file.
+    static bool fromEdgeFile(const string& path, size_t memoryBytes, CompressedGraph& g, int& passes,
+                             string& error) {
+        g = CompressedGraph();
+        unordered_map<int, uint32_t> degreeOf;
+        passes = 1;
+        if (!forEachEdge(path, [&](int u, int v) {
+                degreeOf[u]++;
+                degreeOf[v]++;
+                return true;
+            }, error))
+            return false;
+
+        g.n = degreeOf.size();
+        g.ids.reserve(g.n);
+        for (const auto& entry : degreeOf) g.ids.push_back(entry.first);
+        sort(g.ids.begin(), g.ids.end());
+        vector<uint32_t> degree(g.n);
+        for (int i = 0; i < g.n; ++i) {
+            degree[i] = degreeOf[g.ids[i]];
+            g.arcs += degree[i];
+        }
+        unordered_map<int, uint32_t>().swap(degreeOf);
+
+        g.offsets.assign(g.n + 1, 0);
+        size_t blockArcs = max<size_t>(memoryBytes / sizeof(pair<int, int>), 1);
+        vector<pair<int, int>> block;
+        vector<int> list;
+        for (int lo = 0; lo < g.n;) {
+            int hi = lo;
+            size_t arcsInBlock = 0;
+            while (hi < g.n && (hi == lo || arcsInBlock + degree[hi] <= blockArcs)) arcsInBlock += degree[hi++];
+
+            block.clear();
+            block.reserve(arcsInBlock);
+            passes++;
+            // A file edited between passes shows up as an unknown id or a block
+            // whose arc count differs from the first pass.
+            const string changed = path + " changed while it was being read";
+            bool ok = forEachEdge(path, [&](int u, int v) {
+                int du = g.indexOf(u), dv = g.indexOf(v);
+                if (du < 0 || dv < 0) {
+                    error = changed;
+                    return false;
+                }
+                if (du >= lo && du < hi) block.push_back({du, dv});
+                if (dv >= lo && dv < hi) block.push_back({dv, du});
+                if (block.size() > arcsInBlock) {
+                    error = changed;
+                    return false;
+                }
+                return true;
+            }, error);
+            if (!ok) return false;
+            if (block.size() != arcsInBlock) {
+                error = changed;
+                return false;
+            }
+            sort(block.begin(), block.end());
+
+            size_t k = 0;
+            for (int v = lo; v < hi; ++v) {
+                list.clear();
+                for (; k < block.size() && block[k].first == v; ++k) list.push_back(block[k].second);
+                g.appendList(v, list.data(), list.size());
+            }
+            lo = hi;
+        }
+        g.finish();
+        return true;
+    }
+
+    // Dense index of a vertex id, or -1; a binary search, so no hash table sits
+    // beside the compressed lists.
+    int indexOf(int id) const {
+        if (byId.empty()) {
+            auto it = lower_bound(ids.begin(), ids.end(), id);
+            return it != ids.end() && *it == id ? int(it - ids.begin()) : -1;
+        }
+        auto it = lower_bound(byId.begin(), byId.end(), id, [&](int k, int value) { return ids[k] < value; });
+        return it != byId.end() && ids[*it] == id ? *it : -1;
+    }
+
+    // Calls fn(u) for every neighbour u of v in increasing order.
+    template <typename Fn>
+    void forEachNeighbor(int v, Fn fn) const {
+        const uint8_t* p = listStart(v);
+        const uint8_t* end = listStart(v + 1);
+        if (p == end) return;
+        uint64_t z = getVarint(p);
+        long long u = v + ((z & 1) ? -(long long)((z + 1) >> 1) : (long long)(z >> 1));
+        fn((int)u);
+        while (p < end) {
+            u += getVarint(p);
+            fn((int)u);
+        }
+    }
+
+    vector<int> bfsLevels(int source) const {
+        vector<int> level(n, -1);
+        vector<int> queue;
+        queue.reserve(n);
+        level[source] = 0;
+        queue.push_back(source);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int v = queue[head];
+            int next = level[v] + 1;
+            forEachNeighbor(v, [&](int u) {
+                if (level[u] == -1) {
+                    level[u] = next;
+                    queue.push_back(u);
+                }
+            });
+        }
+        return level;
+    }
+
+    // Same preorder as CompactGraph::dfsPreorder on sorted lists. Each list is
+    // decoded forward into a small buffer so children can be pushed in reverse.
+    vector<int> dfsPreorder(int source) const {
+        vector<int> order;
+        vector<char> visited(n, 0);
+        vector<int> stack{source};
+        vector<int> children;
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            if (visited[v]) continue;
+            visited[v] = 1;
+            order.push_back(v);
+            children.clear();
+            forEachNeighbor(v, [&](int u) {
+                if (!visited[u]) children.push_back(u);
+            });
+            stack.insert(stack.end(), children.rbegin(), children.rend());
+        }
+        return order;
+    }
+
+    size_t bytes() const {
+        return data.size() + offsets.size() * sizeof(uint32_t) + blockBase.size() * sizeof(uint64_t);
+    }
+};
+
+// Relabelling strategies for CompactGraph. Each returns order with order[k] the
+// current index of the vertex that becomes index k; apply() builds the relabelled
+// graph with sorted neighbour lists and carries ids/index along, so results keep
+// reporting the original vertex ids.
+class VertexOrdering {
+public:
+    enum Strategy { NONE, DEGREE, BFS, RCM };
+
+    static const char* name(Strategy s) {
+        switch (s) {
+            case DEGREE: return "degree";
+            case BFS: return "bfs";
+            case RCM: return "rcm";
+            default: return "none";
+        }
+    }
+
+    // Highest degree first, so hubs share cache lines.
+    static vector<int> degreeOrder(const CompactGraph& g) {
+        vector<int> order(g.n);
+        for (int i = 0; i < g.n; ++i) order[i] = i;
+        stable_sort(order.begin(), order.end(), [&](int a, int b) { return g.degree(a) > g.degree(b); });
+        return order;
+    }
+
+    // BFS visit order, one component after another starting from the lowest
+    // unvisited index.
+    static vector<int> bfsOrder(const CompactGraph& g) {
+        return traversalOrder(g, false);
+    }
+
+    // Reverse Cuthill-McKee: BFS per component from a minimum-degree vertex,
+    // children in increasing degree, and the whole order reversed.
+    static vector<int> reverseCuthillMcKee(const CompactGraph& g) {
+        vector<int> order = traversalOrder(g, true);
+        reverse(order.begin(), order.end());
+        return order;
+    }
+
+    static vector<int> order(const CompactGraph& g, Strategy s) {
+        switch (s) {
+            case DEGREE: return degreeOrder(g);
+            case BFS: return bfsOrder(g);
+            case RCM: return reverseCuthillMcKee(g);
+            default: {
+                vector<int> identity(g.n);
+                for (int i = 0; i < g.n; ++i) identity[i] = i;
+                return identity;
+            }
+        }
+    }
+
+    // sortLists = false keeps each list in the order g stores it, which keeps
+    // traversal orders unchanged under relabelling.
+    static CompactGraph apply(const CompactGraph& g, const vector<int>& order, bool sortLists = true) {
+        vector<int> newIndex(g.n);
+        for (int k = 0; k < g.n; ++k) newIndex[order[k]] = k;
+
+        CompactGraph r;
+        r.n = g.n;
+        r.ids.resize(g.n);
+        r.index.reserve(g.n);
+        r.offsets.assign(g.n + 1, 0);
+        r.targets.resize(g.targets.size());
+        for (int k = 0; k < g.n; ++k) {
+            int old = order[k];
+            r.ids[k] = g.ids[old];
+            r.index[r.ids[k]] = k;
+            r.offsets[k + 1] = r.offsets[k] + g.degree(old);
+            int* out = &r.targets[r.offsets[k]];
+            for (int e = g.offsets[old]; e < g.offsets[old + 1]; ++e) *out++ = newIndex[g.targets[e]];
+            if (sortLists) sort(&r.targets[r.offsets[k]], out);
+        }
+        return r;
+    }
+
+private:
+    static vector<int> traversalOrder(const CompactGraph& g, bool cuthillMcKee) {
+        vector<int> order;
+        order.reserve(g.n);
+        vector<char> placed(g.n, 0);
+        vector<int> starts(g.n);
+        for (int i = 0; i < g.n; ++i) starts[i] = i;
+        if (cuthillMcKee)
+            stable_sort(starts.begin(), starts.end(), [&](int a, int b) { return g.degree(a) < g.degree(b); });
+
+        vector<int> children;
+        for (int start : starts) {
+            if (placed[start]) continue;
+            placed[start] = 1;
+            size_t head = order.size();
+            order.push_back(start);
+            while (head < order.size()) {
+                int v = order[head++];
+                children.clear();
+                for (int e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                    int u = g.targets[e];
+                    if (!placed[u]) {
+                        placed[u] = 1;
+                        children.push_back(u);
+                    }
+                }
+                if (cuthillMcKee)
+                    stable_sort(children.begin(), children.end(), [&](int a, int b) { return g.degree(a) < g.degree(b); });
+                order.insert(order.end(), children.begin(), children.end());
+            }
+        }
+        return order;
+    }
+};
+
+// Multi-source BFS over a batch of up to 64 * W sources. Every vertex carries a
+// W-word bitmask per role (seen, frontier, next) with one bit per source, so a
+// single scan of a frontier vertex's neighbours advances every BFS in the batch
+// that currently has that vertex on its frontier.
+template <int W>
+class MultiSourceBFS {
+private:
+    const CompactGraph& g;
+    vector<uint64_t> seen, frontier, next;
+
+public:
+    static const int BATCH = 64 * W;
+
+    explicit MultiSourceBFS(const CompactGraph& graph) : g(graph) {}
+
+    // Runs one batch; onReach(slot, vertex, level) fires once for each source
+    // slot and every vertex it reaches, sources included at level 0.
+    template <typename Fn>
+    void runBatch(const int* sources, int count, Fn onReach) {
+        size_t words = (size_t)g.n * W;
+        seen.assign(words, 0);
+        frontier.assign(words, 0);
+        next.assign(words, 0);
+        for (int s = 0; s < count; ++s) {
+            uint64_t bit = 1ULL << (s % 64);
+            size_t at = (size_t)sources[s] * W + s / 64;
+            seen[at] |= bit;
+            frontier[at] |= bit;
+            onReach(s, sources[s], 0);
+        }
+
+        for (int level = 1;; ++level) {
+            for (int v = 0; v < g.n; ++v) {
+                const uint64_t* f = &frontier[(size_t)v * W];
+                bool active = false;
+                for (int k = 0; k < W; ++k) active |= f[k] != 0;
+                if (!active) continue;
+                for (int e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                    uint64_t* out = &next[(size_t)g.targets[e] * W];
+                    for (int k = 0; k < W; ++k) out[k] |= f[k];
+                }
+            }
+
+            bool any = false;
+            for (int v = 0; v < g.n; ++v) {
+                for (int k = 0; k < W; ++k) {
+                    size_t at = (size_t)v * W + k;
+                    uint64_t fresh = next[at] & ~seen[at];
+                    frontier[at] = fresh;
+                    next[at] = 0;
+                    if (!fresh) continue;
+                    any = true;
+                    seen[at] |= fresh;
+                    while (fresh) {
+                        onReach(k * 64 + __builtin_ctzll(fresh), v, level);
+                        fresh &= fresh - 1;
+                    }
+                }
+            }
+            if (!any) break;
+        }
+    }
+
+    // Level arrays (dense ids, -1 where unreachable), one per source.
+    vector<vector<int>> levels(const vector<int>& sources) {
+        vector<vector<int>> result(sources.size(), vector<int>(g.n, -1));
+        for (size_t base = 0; base < sources.size(); base += BATCH) {
+            int count = (int)min<size_t>(BATCH, sources.size() - base);
+            runBatch(&sources[base], count, [&](int slot, int v, int level) {
+                result[base + slot][v] = level;
+            });
+        }
+        return result;
+    }
+
+    struct SourceStats {
+        long long reached = 0;        // including the source itself
+        long long totalDistance = 0;
+        int eccentricity = 0;         // within the source's component
+
+        double closeness() const {
+            return totalDistance ? (double)(reached - 1) / totalDistance : 0.0;
+        }
+    };
+
+    // Aggregates only, so memory stays O(V * W) whatever the number of sources.
+    vector<SourceStats> stats(const vector<int>& sources) {
+        vector<SourceStats> result(sources.size());
+        for (size_t base = 0; base < sources.size(); base += BATCH) {
+            int count = (int)min<size_t>(BATCH, sources.size() - base);
+            runBatch(&sources[base], count, [&](int slot, int, int level) {
+                SourceStats& st = result[base + slot];
+                st.reached++;
+                st.totalDistance += level;
+                st.eccentricity = max(st.eccentricity, level);
+            });
+        }
+        return result;
+    }
+};
+
+// Connected components of a CompactGraph. Labels are dense, 0 .. count-1, and
+// numbered in order of each component's lowest vertex index, so two labellings
+// of the same partition compare equal element for element.
+struct Components {
+    vector<int> label;   // per dense vertex
+    vector<int> size;    // per component
+    int largest = -1;
+
+    int count() const {
+        return size.size();
+    }
+};
+
+class ConnectedComponents {
+private:
+    // Root of v's tree with path halving.
+    static int find(vector<int>& parent, int v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    // Lock-free hook from the Afforest paper: the higher root is CASed onto the
+    // lower one, retrying from the new parents when another thread won the race.
+    static void link(vector<atomic<int>>& comp, int u, int v) {
+        int p1 = comp[u].load(memory_order_relaxed);
+        int p2 = comp[v].load(memory_order_relaxed);
+        while (p1 != p2) {
+            int high = max(p1, p2), low = min(p1, p2);
+            int pHigh = comp[high].load(memory_order_relaxed);
+            if (pHigh == low) break;
+            if (pHigh == high && comp[high].compare_exchange_strong(pHigh, low, memory_order_relaxed)) break;
+            p1 = comp[comp[high].load(memory_order_relaxed)].load(memory_order_relaxed);
+            p2 = comp[low].load(memory_order_relaxed);
+        }
+    }
+
+    static void compress(vector<atomic<int>>& comp, int threads) {
+        int n = comp.size();
+        search::parallelFor(threads, [&](int t) {
+            for (int v = (long long)n * t / threads; v < (long long)n * (t + 1) / threads; ++v) {
+                int p = comp[v].load(memory_order_relaxed);
+                while (p != comp[p].load(memory_order_relaxed)) {
+                    p = comp[p].load(memory_order_relaxed);
+                    comp[v].store(p, memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    template <typename RootOf>
+    static Components fromRoots(int n, RootOf rootOf) {
+        Components c;
+        c.label.assign(n, -1);
+        vector<int> labelOfRoot(n, -1);
+        for (int v = 0; v < n; ++v) {
+            int r = rootOf(v);
+            if (labelOfRoot[r] == -1) {
+                labelOfRoot[r] = c.size.size();
+                c.size.push_back(0);
+            }
+            c.label[v] = labelOfRoot[r];
+            c.size[c.label[v]]++;
+        }
+        for (int i = 0; i < c.count(); ++i)
+            if (c.largest == -1 || c.size[i] > c.size[c.largest]) c.largest = i;
+        return c;
+    }
+
+public:
+    // Sequential baseline: union by size over every edge.
+    static Components unionFind(const CompactGraph& g) {
+        vector<int> parent(g.n), rank(g.n, 1);
+        for (int v = 0; v < g.n; ++v) parent[v] = v;
+        for (int v = 0; v < g.n; ++v) {
+            for (int e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                int a = find(parent, v), b = find(parent, g.targets[e]);
+                if (a == b) continue;
+                if (rank[a] < rank[b]) swap(a, b);
+                parent[b] = a;
+                rank[a] += rank[b];
+            }
+        }
+        return fromRoots(g.n, [&](int v) { return find(parent, v); });
+    }
+
+    // Afforest: hook along the first neighbourRounds edges of every vertex,
+    // guess the giant component from a random sample, then hook the remaining
+    // edges of vertices outside it only. Edges are stored in both directions,
+    // so skipping the giant component's side of an edge loses nothing. With
+    // neighbourRounds = 0 and no sampling this is plain Shiloach-Vishkin style
+    // hook-and-compress.
+    static Components afforest(const CompactGraph& g, int threads, int neighbourRounds = 2) {
+        int n = g.n;
+        vector<atomic<int>> comp(n);
+        auto range = [&](int t, int& begin, int& end) {
+            begin = (long long)n * t / threads;
+            end = (long long)n * (t + 1) / threads;
+        };
+        search::parallelFor(threads, [&](int t) {
+            int begin, end;
+            range(t, begin, end);
+            for (int v = begin; v < end; ++v) comp[v].store(v, memory_order_relaxed);
+        });
+
+        for (int r = 0; r < neighbourRounds; ++r) {
+            search::parallelFor(threads, [&](int t) {
+                int begin, end;
+                range(t, begin, end);
+                for (int v = begin; v < end; ++v)
+                    if (r < g.degree(v)) link(comp, v, g.targets[g.offsets[v] + r]);
+            });
+            compress(comp, threads);
+        }
+
+        int giant = -1;
+        if (n > 0 && neighbourRounds > 0) {
+            mt19937 rng(12345);
+            unordered_map<int, int> votes;
+            int best = 0;
+            for (int i = 0; i < 1024; ++i) {
+                int c = comp[rng() % n].load(memory_order_relaxed);
+                if (++votes[c] > best) {
+                    best = votes[c];
+                    giant = c;
+                }
+            }
+        }
+
+        search::parallelFor(threads, [&](int t) {
+            int begin, end;
+            range(t, begin, end);
+            for (int v = begin; v < end; ++v) {
+                if (comp[v].load(memory_order_relaxed) == giant) continue;
+                for (int e = g.offsets[v] + neighbourRounds; e < g.offsets[v + 1]; ++e) link(comp, v, g.targets[e]);
+            }
+        });
+        compress(comp, threads);
+
+        return fromRoots(n, [&](int v) { return comp[v].load(memory_order_relaxed); });
+    }
+};
+
 class Graph {
 private:
     unordered_map<int, vector<int>> adjacencyList;
 
+    // CSR copy of the adjacency that the traversals run on, relabelled by
+    // `ordering` so neighbours sit close in memory, and rebuilt on the first
+    // query after an edit. Lists keep insertion order, so every traversal visits
+    // the same vertices in the same order whatever the ordering.
+    VertexOrdering::Strategy ordering = VertexOrdering::BFS;
+    CompactGraph traversal;
+    bool traversalStale = true;
+
+    // Search-library view of the traversal layout. States are dense indices;
+    // index n stands for a start vertex the graph does not contain. The target
+    // only matters to the goal-directed searches.
+    struct Problem {
+        using State = int;
+        using Key = int;
+
+        const CompactGraph& graph;
+        int target;
+
+        int key(int vertex) const { return vertex; }
+        bool isGoal(int vertex) const { return vertex == target; }
+        int heuristic(int) const { return 0; }
+
+        template <typename Emit>
+        void successors(int vertex, Emit&& emit) const {
+            if (vertex == graph.n) return;
+            for (int e = graph.offsets[vertex]; e < graph.offsets[vertex + 1]; ++e)
+                emit(graph.targets[e], 1, e - graph.offsets[vertex]);
+        }
+    };
+
+    const CompactGraph& layout() {
+        if (traversalStale) {
+            CompactGraph base = compact();
+            traversal = VertexOrdering::apply(base, VertexOrdering::order(base, ordering), false);
+            traversalStale = false;
+        }
+        return traversal;
+    }
+
+    // Dense index of a vertex in the layout, or n if the graph lacks it.
+    int indexOf(int vertex) {
+        const CompactGraph& l = layout();
+        auto it = l.index.find(vertex);
+        return it == l.index.end() ? l.n : it->second;
+    }
+
+    // Vertex id of a dense index; index n is the absent start vertex.
+    int idOf(int index, int startVertex) const {
+        return index < traversal.n ? traversal.ids[index] : startVertex;
+    }
+
+    Problem problem(int startVertex, int target) {
+        int goal = indexOf(target);
+        if (goal == layout().n && target != startVertex) goal = -1;
+        return Problem{layout(), goal};
+    }
+
+    void dfsRecursiveHelper(int vertex, int startVertex, vector<char>& visited, vector<int>& result, int level) {
+        visited[vertex] = 1;
+        result.push_back(idOf(vertex, startVertex));
+        cout<<"Node: "<<idOf(vertex, startVertex)<<" Level: "<<level<<endl;
+        if (vertex == traversal.n) return;
+        for (int e = traversal.offsets[vertex]; e < traversal.offsets[vertex + 1]; ++e) {
+            int neighbor = traversal.targets[e];
+            if (!visited[neighbor]) {
+                dfsRecursiveHelper(neighbor, startVertex, visited, result,level+1);
+            }
+        }
+    }
+
 public:
     Graph() = default;
 
@@ -23,6 +810,7 @@ public:
     void addVertex(int vertex) {
         if (adjacencyList.find(vertex) == adjacencyList.end()) {
             adjacencyList[vertex] = vector<int>();
+            traversalStale = true;
         }
     }
 
@@ -31,6 +819,46 @@ public:
         addVertex(vertex2);
         adjacencyList[vertex1].push_back(vertex2);
         adjacencyList[vertex2].push_back(vertex1);
+        traversalStale = true;
+    }
+
+    VertexOrdering::Strategy traversalOrdering() const { return ordering; }
+
+    // Picks the relabelling the traversals use; it takes effect on the next query.
+    void setTraversalOrdering(VertexOrdering::Strategy s) {
+        if (s != ordering) traversalStale = true;
+        ordering = s;
+    }
+
+    // Vertices in ascending id order, neighbour lists in insertion order.
+    CompactGraph compact() const {
+        CompactGraph cg;
+        for (const auto& pair : adjacencyList) cg.ids.push_back(pair.first);
+        sort(cg.ids.begin(), cg.ids.end());
+        cg.n = cg.ids.size();
+        cg.index.reserve(cg.n);
+        for (int i = 0; i < cg.n; ++i) cg.index[cg.ids[i]] = i;
+        cg.offsets.assign(cg.n + 1, 0);
+        for (int i = 0; i < cg.n; ++i) cg.offsets[i + 1] = cg.offsets[i] + adjacencyList.at(cg.ids[i]).size();
+        cg.targets.reserve(cg.offsets[cg.n]);
+        for (int i = 0; i < cg.n; ++i)
+            for (int neighbor : adjacencyList.at(cg.ids[i])) cg.targets.push_back(cg.index[neighbor]);
+        return cg;
+    }
+
+    // Removes every copy of the edge; false if there was none.
+    bool removeEdge(int vertex1, int vertex2) {
+        auto it1 = adjacencyList.find(vertex1);
+        auto it2 = adjacencyList.find(vertex2);
+        if (it1 == adjacencyList.end() || it2 == adjacencyList.end()) return false;
+        vector<int>& list1 = it1->second;
+        size_t before = list1.size();
+        list1.erase(remove(list1.begin(), list1.end(), vertex2), list1.end());
+        if (list1.size() == before) return false;
+        vector<int>& list2 = it2->second;
+        list2.erase(remove(list2.begin(), list2.end(), vertex1), list2.end());
+        traversalStale = true;
+        return true;
     }
 
     void printGraph() {
@@ -44,103 +872,46 @@ public:
         }
     }
 
-    void dfsRecursiveHelper(int vertex, set<int>& visited, vector<int>& result,int level) {
-        visited.insert(vertex);
-        result.push_back(vertex);
-        cout<<"Node: "<<vertex<<" Level: "<<level<<endl;
-        for (int neighbor : adjacencyList[vertex]) {
-            if (visited.find(neighbor) == visited.end()) {
-                dfsRecursiveHelper(neighbor, visited, result,level+1);
-            }
-        }
-    }
-
     vector<int> dfsRecursive(int startVertex) {
-        set<int> visited;
+        int start = indexOf(startVertex);
+        vector<char> visited(traversal.n + 1, 0);
         vector<int> result;
         
-        dfsRecursiveHelper(startVertex, visited, result,0);
+        dfsRecursiveHelper(start, startVertex, visited, result,0);
         return result;
     }
 
     vector<int> dfsNonRecursive(int startVertex) {
         vector<int> result;
-        set<int> visited;
-        stack<int> stack;
-        stack.push(startVertex);
-        while (!stack.empty()) {
-            int currentVertex = stack.top();
-            stack.pop();
-            if (visited.find(currentVertex) != visited.end()) continue;
-            visited.insert(currentVertex);
-            result.push_back(currentVertex);
-            for (int i = adjacencyList[currentVertex].size() - 1; i >= 0; i--) {
-                int neighbor = adjacencyList[currentVertex][i];
-                if (visited.find(neighbor) == visited.end()) {
-                    stack.push(neighbor);
-                }
-            }
-        }
+        search::depthFirst(problem(startVertex, -1), indexOf(startVertex), [&](int vertex, int) {
+            result.push_back(idOf(vertex, startVertex));
+        });
         return result;
     }
 
     vector<int> bfs(int startVertex) {
         vector<int> result;
-        set<int> visited;
-        queue<pair<int,int>> queue;
-        visited.insert(startVertex);
-        queue.push({startVertex,0});
-        while (!queue.empty()) {
-            int currentVertex = queue.front().first;
-            int level = queue.front().second;
-            queue.pop();
-            result.push_back(currentVertex);
-            cout<<"Node: "<<currentVertex<<" Level: "<<level<<endl;
-            for (int neighbor : adjacencyList[currentVertex]) {
-                if (visited.find(neighbor) == visited.end()) {
-                    visited.insert(neighbor);
-                    queue.push({neighbor,level+1});
-                }
-            }
-        }
+        search::breadthFirst(problem(startVertex, -1), indexOf(startVertex), [&](int vertex, int level) {
+            result.push_back(idOf(vertex, startVertex));
+            cout<<"Node: "<<idOf(vertex, startVertex)<<" Level: "<<level<<endl;
+        });
         return result;
     }
 
-    bool dlsRecursiveHelper(int vertex, int target, int depthLimit, set<int>& visited, vector<int>& result) {
-        if (vertex == target) {
-            result.push_back(vertex);
-            return true;
-        }
-        if (depthLimit <= 0) return false;
-        visited.insert(vertex);
-        result.push_back(vertex);
-        for (int neighbor : adjacencyList[vertex]) {
-            if (visited.find(neighbor) == visited.end()) {
-                bool found = dlsRecursiveHelper(neighbor, target, depthLimit - 1, visited, result);
-                if (found) return true;
-            }
-        }
-        result.pop_back();
-        visited.erase(vertex);
-        return false;
-    }
-
     vector<int> depthLimitedSearch(int startVertex, int target, int depthLimit) {
-        set<int> visited;
-        vector<int> result;
-        bool found = dlsRecursiveHelper(startVertex, target, depthLimit, visited, result);
-        if (!found) result.clear();
-        return result;
+        Problem p = problem(startVertex, target);
+        vector<int> path = search::DepthLimitedSearch<Problem>(p).run(indexOf(startVertex), depthLimit);
+        for (int& v : path) v = idOf(v, startVertex);
+        return path;
     }
 
     vector<int> iterativeDeepeningDFS(int startVertex, int target, int maxDepth) {
-        vector<int> result;
-        for (int depth = 0; depth <= maxDepth; depth++) {
-            cout << "Trying depth limit: " << depth << endl;
-            result = depthLimitedSearch(startVertex, target, depth);
-            if (!result.empty()) return result;
-        }
-        return result;
+        Problem p = problem(startVertex, target);
+        auto announce = [](int depth) { cout << "Trying depth limit: " << depth << endl; };
+        vector<int> path =
+            search::DepthLimitedSearch<Problem>(p).iterativeDeepening(indexOf(startVertex), maxDepth, announce);
+        for (int& v : path) v = idOf(v, startVertex);
+        return path;
     }
 };
 
@@ -152,6 +923,310 @@ void printTraversal(const vector<int>& traversal, const string& traversalType) {
     cout << endl;
 }
 
+// BFS from every vertex, batched 256 sources at a time, then the same work as
+// independent BFS runs for comparison.
+void runBatchedBfs(const Graph& g) {
+    CompactGraph cg = g.compact();
+    if (cg.n == 0) {
+        cout << "Graph has no vertices.\n";
+        return;
+    }
+    vector<int> sources(cg.n);
+    for (int i = 0; i < cg.n; ++i) sources[i] = i;
+
+    search::Stopwatch timer;
+    MultiSourceBFS<4> msbfs(cg);
+    vector<MultiSourceBFS<4>::SourceStats> stats = msbfs.stats(sources);
+    double batchedMs = timer.elapsedMs();
+
+    timer.reset();
+    bool matches = true;
+    for (int s = 0; s < cg.n; ++s) {
+        vector<int> level = cg.bfsLevels(s);
+        long long reached = 0, total = 0;
+        int ecc = 0;
+        for (int d : level) {
+            if (d < 0) continue;
+            reached++;
+            total += d;
+            ecc = max(ecc, d);
+        }
+        if (reached != stats[s].reached || total != stats[s].totalDistance || ecc != stats[s].eccentricity)
+            matches = false;
+    }
+    double singleMs = timer.elapsedMs();
+
+    if (cg.n <= 50) {
+        cout << "Vertex  Reached  Eccentricity  Closeness\n";
+        for (int s = 0; s < cg.n; ++s)
+            cout << setw(6) << cg.ids[s] << setw(9) << stats[s].reached << setw(14) << stats[s].eccentricity
+                 << setw(11) << fixed << setprecision(4) << stats[s].closeness() << "\n";
+    }
+    int diameter = 0;
+    for (const auto& st : stats) diameter = max(diameter, st.eccentricity);
+    cout << cg.n << " sources, largest eccentricity " << diameter << ".\n";
+    cout << "Batched BFS: " << fixed << setprecision(2) << batchedMs << " ms, independent BFS: " << singleMs
+         << " ms, results " << (matches ? "match" : "DIFFER") << ".\n";
+}
+
+void runComponents(const Graph& g) {
+    CompactGraph cg = g.compact();
+    if (cg.n == 0) {
+        cout << "Graph has no vertices.\n";
+        return;
+    }
+    int threads = search::defaultThreadCount();
+
+    search::Stopwatch timer;
+    Components sequential = ConnectedComponents::unionFind(cg);
+    double unionFindMs = timer.elapsedMs();
+    timer.reset();
+    Components parallel = ConnectedComponents::afforest(cg, threads);
+    double afforestMs = timer.elapsedMs();
+
+    cout << parallel.count() << " connected component(s); the largest has "
+         << parallel.size[parallel.largest] << " of " << cg.n << " vertices.\n";
+    if (cg.n <= 50) {
+        vector<vector<int>> members(parallel.count());
+        for (int v = 0; v < cg.n; ++v) members[parallel.label[v]].push_back(cg.ids[v]);
+        for (int c = 0; c < parallel.count(); ++c) {
+            cout << "Component " << c << " (" << parallel.size[c] << "): ";
+            for (int id : members[c]) cout << id << " ";
+            cout << "\n";
+        }
+    }
+    cout << "Union-find: " << fixed << setprecision(2) << unionFindMs << " ms, Afforest on " << threads
+         << " thread(s): " << afforestMs << " ms, labels "
+         << (sequential.label == parallel.label ? "match" : "DIFFER") << ".\n";
+}
+
+// Times BFS and DFS from the same sample of sources under every ordering and
+// checks that BFS levels, read back through the id map, agree with the original
+// numbering. Then lets the user pick the ordering the traversal options run on.
+void runReorderingBenchmark(Graph& g) {
+    CompactGraph base = g.compact();
+    if (base.n == 0) {
+        cout << "Graph has no vertices.\n";
+        return;
+    }
+    int samples = min(base.n, 16);
+    vector<int> sourceIds;
+    for (int i = 0; i < samples; ++i) sourceIds.push_back(base.ids[(long long)base.n * i / samples]);
+    vector<vector<int>> reference;
+    for (int id : sourceIds) reference.push_back(base.bfsLevels(base.index.at(id)));
+
+    cout << "Ordering  Build ms   BFS ms   DFS ms      Avg gap  Levels\n";
+    const VertexOrdering::Strategy strategies[] = {VertexOrdering::NONE, VertexOrdering::DEGREE,
+                                                   VertexOrdering::BFS, VertexOrdering::RCM};
+    for (VertexOrdering::Strategy s : strategies) {
+        search::Stopwatch timer;
+        CompactGraph cg = VertexOrdering::apply(base, VertexOrdering::order(base, s));
+        double buildMs = timer.elapsedMs();
+
+        timer.reset();
+        vector<vector<int>> levels;
+        for (int id : sourceIds) levels.push_back(cg.bfsLevels(cg.index.at(id)));
+        double bfsMs = timer.elapsedMs();
+
+        timer.reset();
+        for (int id : sourceIds) cg.dfsPreorder(cg.index.at(id));
+        double dfsMs = timer.elapsedMs();
+
+        bool matches = true;
+        for (int i = 0; i < samples && matches; ++i)
+            for (int v = 0; v < base.n && matches; ++v)
+                matches = reference[i][v] == levels[i][cg.index.at(base.ids[v])];
+
+        cout << left << setw(8) << VertexOrdering::name(s) << right << fixed << setprecision(2)
+             << setw(10) << buildMs << setw(9) << bfsMs << setw(9) << dfsMs << setw(13) << cg.averageGap()
+             << "  " << (matches ? "match" : "DIFFER") << "\n";
+    }
+    cout.unsetf(ios::fixed);
+
+    int choice;
+    cout << "Ordering for the BFS/DFS/DLS/IDDFS options (0 none, 1 degree, 2 bfs, 3 rcm; current "
+         << VertexOrdering::name(g.traversalOrdering()) << "): ";
+    cin >> choice;
+    if (choice >= 0 && choice < (int)(sizeof(strategies) / sizeof(strategies[0]))) {
+        g.setTraversalOrdering(strategies[choice]);
+        cout << "Traversals now use the " << VertexOrdering::name(strategies[choice]) << " ordering.\n";
+    }
+}
+
+// Compares the plain CSR with the varint-compressed form, both in input order
+// and after BFS reordering (which shrinks the gaps), on footprint and on BFS/DFS
+// time from the same sources. Results are checked against the plain CSR.
+void runCompressionBenchmark(const Graph& g) {
+    CompactGraph base = g.compact();
+    if (base.n == 0) {
+        cout << "Graph has no vertices.\n";
+        return;
+    }
+    int samples = min(base.n, 16);
+    vector<int> sourceIds;
+    for (int i = 0; i < samples; ++i) sourceIds.push_back(base.ids[(long long)base.n * i / samples]);
+
+    cout << "Layout              Bytes   Ratio   BFS ms   DFS ms  Results\n";
+    for (VertexOrdering::Strategy s : {VertexOrdering::NONE, VertexOrdering::BFS}) {
+        CompactGraph csr = VertexOrdering::apply(base, VertexOrdering::order(base, s));
+        CompressedGraph packed(csr);
+        size_t csrBytes = (csr.offsets.size() + csr.targets.size()) * sizeof(int);
+
+        search::Stopwatch timer;
+        vector<vector<int>> csrLevels, csrOrders;
+        for (int id : sourceIds) csrLevels.push_back(csr.bfsLevels(csr.index.at(id)));
+        double csrBfs = timer.elapsedMs();
+        timer.reset();
+        for (int id : sourceIds) csrOrders.push_back(csr.dfsPreorder(csr.index.at(id)));
+        double csrDfs = timer.elapsedMs();
+
+        timer.reset();
+        vector<vector<int>> packedLevels, packedOrders;
+        for (int id : sourceIds) packedLevels.push_back(packed.bfsLevels(packed.indexOf(id)));
+        double packedBfs = timer.elapsedMs();
+        timer.reset();
+        for (int id : sourceIds) packedOrders.push_back(packed.dfsPreorder(packed.indexOf(id)));
+        double packedDfs = timer.elapsedMs();
+
+        // apply() sorts neighbour lists, so both layouts visit in the same order.
+        bool matches = csrLevels == packedLevels && csrOrders == packedOrders;
+        string order = VertexOrdering::name(s);
+        cout << fixed << setprecision(2)
+             << left << setw(14) << ("csr/" + order) << right << setw(11) << csrBytes << setw(8) << 1.0
+             << setw(9) << csrBfs << setw(9) << csrDfs << "\n"
+             << left << setw(14) << ("varint/" + order) << right << setw(11) << packed.bytes()
+             << setw(8) << (double)csrBytes / packed.bytes() << setw(9) << packedBfs << setw(9) << packedDfs
+             << "  " << (matches ? "match" : "DIFFER") << "\n";
+    }
+}
+
+// Builds the compressed form straight from an edge-list file, for graphs whose
+// uncompressed adjacency would not fit in memory, and times BFS/DFS on it.
+void runStreamedCompression() {
+    string path;
+    size_t memoryMb;
+    cout << "Enter edge-list file (one 'u v' per line, undirected): ";
+    cin >> path;
+    cout << "Memory budget for one block of arcs in MB (e.g., 64): ";
+    cin >> memoryMb;
+
+    search::resetPeakRss();
+    search::Stopwatch timer;
+    CompressedGraph packed;
+    int passes;
+    string error;
+    if (!CompressedGraph::fromEdgeFile(path, max<size_t>(memoryMb, 1) << 20, packed, passes, error)) {
+        cout << "Error: " << error << "\n";
+        return;
+    }
+    double buildMs = timer.elapsedMs();
+    if (packed.n == 0) {
+        cout << "Graph has no vertices.\n";
+        return;
+    }
+    size_t csrBytes = (packed.n + 1 + packed.arcs) * sizeof(int);
+    cout << fixed << setprecision(2);
+    cout << packed.n << " vertices, " << packed.arcs << " arcs, built in " << buildMs << " ms over " << passes
+         << " file passes\n";
+    cout << "Compressed: " << packed.bytes() << " bytes (CSR would need " << csrBytes << ", "
+         << (double)csrBytes / packed.bytes() << "x), peak RSS " << search::peakRssKb() / 1024.0 << " MB\n";
+
+    int samples = min(packed.n, 16);
+    timer.reset();
+    long long reached = 0;
+    for (int i = 0; i < samples; ++i) {
+        vector<int> level = packed.bfsLevels((int)((long long)packed.n * i / samples));
+        reached += count_if(level.begin(), level.end(), [](int l) { return l >= 0; });
+    }
+    double bfsMs = timer.elapsedMs();
+    timer.reset();
+    for (int i = 0; i < samples; ++i) packed.dfsPreorder((int)((long long)packed.n * i / samples));
+    cout << "BFS from " << samples << " sources: " << bfsMs << " ms (" << reached << " vertices reached), DFS: "
+         << timer.elapsedMs() << " ms\n";
+    cout.unsetf(ios::fixed);
+}
+
+// Keeps BFS levels from one source current while batches of "+ u v" / "- u v"
+// edge updates are applied to the graph, and checks every batch against a full
+// recompute.
+void runDynamicBfs(Graph& g) {
+    CompactGraph cg = g.compact();
+    int sourceId;
+    cout << "Enter source vertex: ";
+    cin >> sourceId;
+    if (!cg.index.count(sourceId)) {
+        cout << "Vertex " << sourceId << " is not in the graph.\n";
+        return;
+    }
+
+    vector<int> ids = cg.ids;
+    unordered_map<int, int> index = cg.index;
+    search::DynamicShortestPaths levels(cg.n, index[sourceId]);
+    for (int v = 0; v < cg.n; ++v)
+        for (int e = cg.offsets[v]; e < cg.offsets[v + 1]; ++e) levels.addArc(v, cg.targets[e], 1);
+    levels.recompute();
+
+    auto denseId = [&](int id) {
+        auto it = index.find(id);
+        if (it != index.end()) return it->second;
+        ids.push_back(id);
+        return index[id] = levels.addVertex();
+    };
+
+    while (true) {
+        int count;
+        cout << "Number of updates in the next batch (0 to stop): ";
+        cin >> count;
+        if (!cin || count <= 0) break;
+        cout << "Enter " << count << " updates (format: + vertex1 vertex2 or - vertex1 vertex2):\n";
+        vector<search::DynamicShortestPaths::Update> batch;
+        for (int i = 0; i < count; ++i) {
+            char op;
+            int a, b;
+            cin >> op >> a >> b;
+            if (op == '+') {
+                g.addEdge(a, b);
+                int u = denseId(a), v = denseId(b);
+                batch.push_back({u, v, 1, true});
+                batch.push_back({v, u, 1, true});
+            } else if (g.removeEdge(a, b)) {
+                int u = index[a], v = index[b];
+                batch.push_back({u, v, 1, false});
+                batch.push_back({v, u, 1, false});
+            }
+        }
+
+        search::Stopwatch timer;
+        long long touched = levels.apply(batch);
+        double incrementalMs = timer.elapsedMs();
+
+        timer.reset();
+        CompactGraph fresh = g.compact();
+        vector<int> reference = fresh.bfsLevels(fresh.index.at(sourceId));
+        double recomputeMs = timer.elapsedMs();
+
+        bool matches = true;
+        const vector<long long>& dist = levels.distances();
+        for (int v = 0; v < (int)ids.size() && matches; ++v) {
+            int expected = reference[fresh.index.at(ids[v])];
+            matches = expected == (dist[v] == search::DynamicShortestPaths::UNREACHABLE ? -1 : dist[v]);
+        }
+
+        if (ids.size() <= 50) {
+            cout << "Levels:";
+            for (int v = 0; v < (int)ids.size(); ++v) {
+                cout << " " << ids[v] << ":";
+                if (dist[v] == search::DynamicShortestPaths::UNREACHABLE) cout << "-";
+                else cout << dist[v];
+            }
+            cout << "\n";
+        }
+        cout << "Repaired levels touching " << touched << " of " << ids.size() << " vertices in " << fixed
+             << setprecision(3) << incrementalMs << " ms (full recompute " << recomputeMs << " ms), levels "
+             << (matches ? "match" : "DIFFER") << ".\n";
+    }
+}
+
 int main() {
     Graph* g = nullptr;
     int choice;
@@ -167,7 +1242,12 @@ int main() {
         cout << "6. BFS\n";
         cout << "7. Depth-Limited Search (DLS)\n";
         cout << "8. Iterative Deepening DFS (IDDFS)\n";
-        cout << "9. Exit\n";
+        cout << "9. Batched BFS from All Vertices\n";
+        cout << "10. Connected Components\n";
+        cout << "11. Vertex Reordering Benchmark\n";
+        cout << "12. Compressed Adjacency Benchmark\n";
+        cout << "13. Dynamic BFS Levels (batched edge updates)\n";
+        cout << "14. Exit\n";
         cout << "Enter your choice: ";
         cin >> choice;
 
@@ -256,13 +1336,48 @@ int main() {
                 break;
 
             case 9:
+                if (!g) { cout << "Please initialize the graph first.\n"; break; }
+                runBatchedBfs(*g);
+                break;
+
+            case 10:
+                if (!g) { cout << "Please initialize the graph first.\n"; break; }
+                runComponents(*g);
+                break;
+
+            case 11:
+                if (!g) { cout << "Please initialize the graph first.\n"; break; }
+                runReorderingBenchmark(*g);
+                break;
+
+            case 12: {
+                int source;
+                cout << "1. Compare layouts on the loaded graph\n";
+                cout << "2. Build from an edge-list file without loading it\n";
+                cout << "Enter your choice: ";
+                cin >> source;
+                if (source == 2) {
+                    runStreamedCompression();
+                    break;
+                }
+                if (!g) { cout << "Please initialize the graph first.\n"; break; }
+                runCompressionBenchmark(*g);
+                break;
+            }
+
+            case 13:
+                if (!g) { cout << "Please initialize the graph first.\n"; break; }
+                runDynamicBfs(*g);
+                break;
+
+            case 14:
                 cout << "Exiting program." << endl;
                 break;
 
             default:
                 cout << "Invalid choice. Please try again." << endl;
         }
-    } while (choice != 9);
+    } while (choice != 14);
 
     delete g;
     return 0;
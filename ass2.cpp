@@ -1,9 +1,9 @@
 #include <iostream>
-#include <iostream>
 #include <vector>
 #include <queue>
 #include <algorithm>
 #include <unordered_set>
+#include "search.hpp"
 
 using namespace std;
 
@@ -74,74 +74,125 @@ bool isValid(int row, int col)
     return (row >= 0 && row < N && col >= 0 && col < N);
 }
 
-vector<PuzzleState> generateNextStates(const PuzzleState &currentState)
+// The puzzle as a search-library problem: children are the blank moved left,
+// right, up and down, and the key packs the board into a 9-digit integer.
+struct PuzzleProblem
 {
-    vector<PuzzleState> nextStates;
-    const int moves[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}}; // Left, Right, Up, Down
+    using State = PuzzleState;
+    using Key = int;
+
+    PuzzleState goal;
+
+    int key(const PuzzleState &state) const
+    {
+        int hash = 0;
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                hash = hash * 10 + state.puzzle[i][j];
+        return hash;
+    }
+
+    bool isGoal(const PuzzleState &state) const
+    {
+        return isEqual(state, goal);
+    }
+
+    int heuristic(const PuzzleState &state) const
+    {
+        return calculateManhattanDistance(state);
+    }
 
-    for (int k = 0; k < 4; k++)
+    template <typename Emit>
+    void successors(const PuzzleState &currentState, Emit &&emit) const
     {
-        int nextZeroRow = currentState.zeroRow + moves[k][0];
-        int nextZeroCol = currentState.zeroCol + moves[k][1];
+        const int moves[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}}; // Left, Right, Up, Down
 
-        if (isValid(nextZeroRow, nextZeroCol))
+        for (int k = 0; k < 4; k++)
         {
-            PuzzleState nextState = currentState;
-            swap(nextState.puzzle[currentState.zeroRow][currentState.zeroCol],
-                 nextState.puzzle[nextZeroRow][nextZeroCol]);
-            nextState.zeroRow = nextZeroRow;
-            nextState.zeroCol = nextZeroCol;
-            nextState.g = currentState.g + 1;
-            nextState.h = calculateManhattanDistance(nextState);
-            nextStates.push_back(nextState);
+            int nextZeroRow = currentState.zeroRow + moves[k][0];
+            int nextZeroCol = currentState.zeroCol + moves[k][1];
+
+            if (isValid(nextZeroRow, nextZeroCol))
+            {
+                PuzzleState nextState = currentState;
+                swap(nextState.puzzle[currentState.zeroRow][currentState.zeroCol],
+                     nextState.puzzle[nextZeroRow][nextZeroCol]);
+                nextState.zeroRow = nextZeroRow;
+                nextState.zeroCol = nextZeroCol;
+                nextState.g = currentState.g + 1;
+                nextState.h = calculateManhattanDistance(nextState);
+                emit(nextState, 1, k);
+            }
         }
     }
+};
 
-    return nextStates;
+void printSearchStep(const PuzzleState &state, int moves, int heuristic)
+{
+    cout << "Current State:\n";
+    printPuzzle(state);
+    cout << "Number of moves: " << moves << endl;
+    cout << "Heuristic cost: " << heuristic << endl;
+    cout << "-------------------\n";
 }
 
-void aStarSearch(const PuzzleState &initialState, const PuzzleState &finalState)
+struct ExpansionPrinter
 {
-    priority_queue<PuzzleState> pq;
-    unordered_set<int> visited;
-
-    pq.push(initialState);
-
-    while (!pq.empty())
+    template <typename Node>
+    void expanded(const Node &node, int)
     {
-        PuzzleState current = pq.top();
-        pq.pop();
+        printSearchStep(node.state, node.g, node.h);
+    }
 
-        cout << "Current State:\n";
-        printPuzzle(current);
-        cout << "Number of moves: " << current.g << endl;
-        cout << "Heuristic cost: " << current.h << endl;
-        cout << "-------------------\n";
+    template <typename Node>
+    void generated(const Node &, int) {}
+};
 
-        if (isEqual(current, finalState))
-        {
-            cout << "Goal State Reached!\n";
-            cout << "Number of moves: " << current.g << endl;
-            cout << "Heuristic cost: " << current.h << endl;
-            return;
-        }
+void printResult(const search::SearchResult<PuzzleState> &result)
+{
+    if (result.found)
+    {
+        const PuzzleState &goal = result.path.back();
+        printSearchStep(goal, result.cost, goal.h);
+        cout << "Goal State Reached!\n";
+        cout << "Number of moves: " << result.cost << endl;
+        cout << "Heuristic cost: " << goal.h << endl;
+    }
+}
 
-        vector<PuzzleState> nextStates = generateNextStates(current);
+void aStarSearch(const PuzzleState &initialState, const PuzzleState &finalState)
+{
+    PuzzleProblem problem{finalState};
+    search::BestFirstSearch<PuzzleProblem> astar(problem);
+    printResult(astar.run(initialState, search::BestFirstOptions(), ExpansionPrinter()));
+}
 
-        for (const PuzzleState &nextState : nextStates)
-        {
-            int hash = 0;
-            for (int i = 0; i < N; i++)
-                for (int j = 0; j < N; j++)
-                    hash = hash * 10 + nextState.puzzle[i][j];
+// Greedy best-first: A* with the path cost left out of the ordering.
+void greedySearch(const PuzzleState &initialState, const PuzzleState &finalState)
+{
+    PuzzleProblem problem{finalState};
+    search::BestFirstSearch<PuzzleProblem> greedy(problem);
+    search::BestFirstOptions options;
+    options.gWeight = 0;
+    printResult(greedy.run(initialState, options, ExpansionPrinter()));
+}
 
-            if (visited.find(hash) == visited.end())
-            {
-                pq.push(nextState);
-                visited.insert(hash);
-            }
-        }
-    }
+void beamSearch(const PuzzleState &initialState, const PuzzleState &finalState)
+{
+    search::BeamOptions options;
+    size_t memoryMb;
+    cout << "Enter the beam width: ";
+    cin >> options.width;
+    cout << "Enter the memory cap in MB: ";
+    cin >> memoryMb;
+    options.maxBytes = memoryMb << 20;
+
+    PuzzleProblem problem{finalState};
+    search::BeamSearch<PuzzleProblem> beam(problem);
+    search::SearchResult<PuzzleState> result = beam.run(initialState, options, ExpansionPrinter());
+    printResult(result);
+    if (!result.found)
+        cout << (result.truncated ? "Memory cap reached before the goal.\n" : "The beam lost the goal; try a wider beam.\n");
 }
 
 PuzzleState getPuzzleState(const string &prompt)
@@ -175,10 +226,23 @@ int main()
     PuzzleState initialState = getPuzzleState("Enter the initial state of the puzzle");
     PuzzleState finalState = getPuzzleState("Enter the final state of the puzzle");
 
+    int choice;
+    cout << "Choose a search strategy:\n";
+    cout << "1. A* search\n";
+    cout << "2. Greedy best-first search\n";
+    cout << "3. Beam search\n";
+    cout << "Enter your choice: ";
+    cin >> choice;
+
     cout << "Initial State:\n";
     printPuzzle(initialState);
 
-    aStarSearch(initialState, finalState);
+    if (choice == 2)
+        greedySearch(initialState, finalState);
+    else if (choice == 3)
+        beamSearch(initialState, finalState);
+    else
+        aStarSearch(initialState, finalState);
 
     return 0;
 }
\ No newline at end of file
@@ -1,42 +1,624 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <queue>
+#include <thread>
+#include <climits>
+#include <limits>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <array>
+#include <utility>
+#include <cstdio>
+#include <cctype>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include "search.hpp"
+#include "graph.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 using namespace std;
 
 #define INF 9999
 
-class SelectionSort {
+using search::parallelFor;
+using search::defaultThreadCount;
+
+// Sorts chunks on separate threads, then merges neighbouring runs pairwise.
+template <typename T, typename Less>
+void parallelSort(vector<T>& data, Less less, int threads) {
+    size_t n = data.size();
+    if (threads <= 1 || n < 100000) {
+        sort(data.begin(), data.end(), less);
+        return;
+    }
+    vector<size_t> bounds(threads + 1);
+    for (int t = 0; t <= threads; t++)
+        bounds[t] = n * t / threads;
+    parallelFor(threads, [&](int t) {
+        sort(data.begin() + bounds[t], data.begin() + bounds[t + 1], less);
+    });
+    for (int width = 1; width < threads; width *= 2) {
+        int pairs = (threads + 2 * width - 1) / (2 * width);
+        parallelFor(pairs, [&](int p) {
+            int lo = 2 * width * p;
+            int mid = min(lo + width, threads);
+            int hi = min(lo + 2 * width, threads);
+            if (mid < hi)
+                inplace_merge(data.begin() + bounds[lo], data.begin() + bounds[mid],
+                              data.begin() + bounds[hi], less);
+        });
+    }
+}
+
+// One compare-exchange of a sorting network.
+struct Comparator {
+    int lo, hi;
+};
+
+// Batcher's odd-even merge sort network for `size` inputs, clipped so sizes that
+// are not powers of two need no padding. Writes the comparators to out when it is
+// non-null and returns how many there are.
+constexpr int batcherComparators(int size, Comparator* out) {
+    int count = 0;
+    for (int p = 1; p < size; p <<= 1)
+        for (int k = p; k >= 1; k >>= 1)
+            for (int j = k % p; j + k < size; j += 2 * k)
+                for (int i = 0; i < k && i < size - j - k; i++)
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        if (out != nullptr)
+                            out[count] = {i + j, i + j + k};
+                        count++;
+                    }
+    return count;
+}
+
+template <int SIZE>
+constexpr array<Comparator, batcherComparators(SIZE, nullptr)> makeBatcherNetwork() {
+    array<Comparator, batcherComparators(SIZE, nullptr)> network{};
+    batcherComparators(SIZE, network.data());
+    return network;
+}
+
+template <int SIZE>
+constexpr auto BATCHER_NETWORK = makeBatcherNetwork<SIZE>();
+
+// Sorting for 32/64-bit integer keys. sort() picks LSD radix sort for large inputs,
+// a parallel sample sort when several threads are available, and a pdqsort-style
+// introsort for small ones. Radix and sample sort need a scratch buffer the size of
+// the input; indices are size_t throughout so 10^9-element arrays are fine.
+template <typename T>
+class IntegerSorter {
+    static_assert(is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "IntegerSorter supports 32- and 64-bit integer keys");
+
+private:
+    typedef typename make_unsigned<T>::type Key;
+
+    static constexpr int NETWORK_SIZE = 16;
+    static constexpr size_t RADIX_CUTOFF = 1024;
+
+    template <int LO, int HI>
+    static void compareExchange(T* v) {
+        T lo = min(v[LO], v[HI]);
+        T hi = max(v[LO], v[HI]);
+        v[LO] = lo;
+        v[HI] = hi;
+    }
+
+    template <int SIZE, size_t... I>
+    static void networkSortUnrolled([[maybe_unused]] T* a, index_sequence<I...>) {
+        (compareExchange<BATCHER_NETWORK<SIZE>[I].lo, BATCHER_NETWORK<SIZE>[I].hi>(a), ...);
+    }
+
+    template <int SIZE>
+    static void networkSortFixed(T* a) {
+        networkSortUnrolled<SIZE>(a, make_index_sequence<BATCHER_NETWORK<SIZE>.size()>());
+    }
+
+    template <size_t... SIZES>
+    static void networkSort(T* a, size_t n, index_sequence<SIZES...>) {
+        static constexpr void (*sorters[])(T*) = {&networkSortFixed<SIZES>...};
+        sorters[n](a);
+    }
+
+    // Partitions of up to NETWORK_SIZE elements run through the Batcher network
+    // for their exact size. Every network is generated at compile time and
+    // unrolled, so each compare-exchange has constant indices and compiles to
+    // branch-free min/max (cmov) instead of mispredicting like insertion sort.
+    static void networkSort(T* a, size_t n) {
+        networkSort(a, n, make_index_sequence<NETWORK_SIZE + 1>());
+    }
+
+    static void sort3(T* a, T* b, T* c) {
+        if (*b < *a) swap(*a, *b);
+        if (*c < *b) swap(*b, *c);
+        if (*b < *a) swap(*a, *b);
+    }
+
+    // Insertion sort that gives up after a few moves; used to finish ranges a
+    // partition found already in order.
+    static bool partialInsertionSort(T* begin, T* end) {
+        size_t moves = 0;
+        for (T* cur = begin + 1; cur < end; cur++) {
+            T* sift = cur;
+            T tmp = *sift;
+            while (sift != begin && tmp < sift[-1]) {
+                *sift = sift[-1];
+                sift--;
+            }
+            *sift = tmp;
+            moves += cur - sift;
+            if (moves > 8)
+                return false;
+        }
+        return true;
+    }
+
+    // Moves elements equal to the pivot left; only called when the element just
+    // before the range is not less than the pivot, so every such element is equal.
+    static T* partitionLeft(T* begin, T* end) {
+        T pivot = *begin;
+        T* first = begin;
+        T* last = end;
+        while (pivot < *--last) {
+        }
+        if (last + 1 == end)
+            while (first < last && !(pivot < *++first)) {
+            }
+        else
+            while (!(pivot < *++first)) {
+            }
+        while (first < last) {
+            swap(*first, *last);
+            while (pivot < *--last) {
+            }
+            while (!(pivot < *++first)) {
+            }
+        }
+        *begin = *last;
+        *last = pivot;
+        return last;
+    }
+
+    static T* partitionRight(T* begin, T* end, bool& alreadyPartitioned) {
+        T pivot = *begin;
+        T* first = begin;
+        T* last = end;
+        while (*++first < pivot) {
+        }
+        if (first - 1 == begin)
+            while (first < last && !(*--last < pivot)) {
+            }
+        else
+            while (!(*--last < pivot)) {
+            }
+        alreadyPartitioned = first >= last;
+        while (first < last) {
+            swap(*first, *last);
+            while (*++first < pivot) {
+            }
+            while (!(*--last < pivot)) {
+            }
+        }
+        T* pivotPos = first - 1;
+        *begin = *pivotPos;
+        *pivotPos = pivot;
+        return pivotPos;
+    }
+
+    static void introLoop(T* begin, T* end, int badAllowed, bool leftmost) {
+        while (end - begin > NETWORK_SIZE) {
+            size_t n = end - begin;
+            T* mid = begin + n / 2;
+            if (n > 128) {
+                sort3(begin, mid, end - 1);
+                sort3(begin + 1, mid - 1, end - 2);
+                sort3(begin + 2, mid + 1, end - 3);
+                sort3(mid - 1, mid, mid + 1);
+            } else {
+                sort3(begin, mid, end - 1);
+            }
+            swap(*begin, *mid);
+
+            if (!leftmost && !(begin[-1] < *begin)) {
+                begin = partitionLeft(begin, end) + 1;
+                continue;
+            }
+
+            bool alreadyPartitioned;
+            T* pivotPos = partitionRight(begin, end, alreadyPartitioned);
+            size_t leftSize = pivotPos - begin;
+            size_t rightSize = end - (pivotPos + 1);
+
+            if (leftSize < n / 8 || rightSize < n / 8) {
+                if (--badAllowed == 0) {
+                    make_heap(begin, end);
+                    sort_heap(begin, end);
+                    return;
+                }
+            } else if (alreadyPartitioned && partialInsertionSort(begin, pivotPos) &&
+                       partialInsertionSort(pivotPos + 1, end)) {
+                return;
+            }
+
+            introLoop(begin, pivotPos, badAllowed, leftmost);
+            begin = pivotPos + 1;
+            leftmost = false;
+        }
+        networkSort(begin, end - begin);
+    }
+
 public:
-    SelectionSort() {
-        cout << "Selection Sort Algorithm\n";
-        cout << "--------------------------\n";
-        cout << "Enter number of elements: ";
-        int n;
-        cin >> n;
-        vector<int> arr(n);
-        cout << "Enter elements:\n";
-        for (int i = 0; i < n; i++)
-            cin >> arr[i];
+    static void introSort(T* begin, T* end) {
+        size_t n = end - begin;
+        if (n < 2)
+            return;
+        int log2n = 0;
+        while ((n >> log2n) > 1)
+            log2n++;
+        introLoop(begin, end, log2n, true);
+    }
+
+    // LSD radix sort on 8-bit digits. All digit histograms come from one pass and
+    // passes where every key has the same digit are skipped. Signed keys have their
+    // sign bit flipped so the unsigned digit order matches.
+    static void radixSort(T* a, T* scratch, size_t n) {
+        if (n < RADIX_CUTOFF) {
+            introSort(a, a + n);
+            return;
+        }
+        const int PASSES = sizeof(T);
+        const Key flip = is_signed<T>::value ? Key(1) << (8 * sizeof(T) - 1) : Key(0);
+        vector<size_t> counts(PASSES * 256, 0);
+        for (size_t i = 0; i < n; i++) {
+            Key k = Key(a[i]) ^ flip;
+            for (int p = 0; p < PASSES; p++)
+                counts[p * 256 + ((k >> (8 * p)) & 0xff)]++;
+        }
 
-        sort(arr);
+        T* src = a;
+        T* dst = scratch;
+        for (int p = 0; p < PASSES; p++) {
+            size_t* count = &counts[p * 256];
+            if (count[((Key(src[0]) ^ flip) >> (8 * p)) & 0xff] == n)
+                continue;
+            size_t sum = 0;
+            for (int d = 0; d < 256; d++) {
+                size_t c = count[d];
+                count[d] = sum;
+                sum += c;
+            }
+            for (size_t i = 0; i < n; i++)
+                dst[count[((Key(src[i]) ^ flip) >> (8 * p)) & 0xff]++] = src[i];
+            swap(src, dst);
+        }
+        if (src != a)
+            copy(src, src + n, a);
+    }
 
-        cout << "Sorted array:\n";
+    static void radixSort(T* a, size_t n) {
+        vector<T> scratch(n < RADIX_CUTOFF ? 0 : n);
+        radixSort(a, scratch.data(), n);
+    }
+
+    // Parallel sample sort: oversampled splitters cut the keys into 4 buckets per
+    // thread, threads count and scatter their own chunk, then buckets are radix
+    // sorted independently using the vacated input as scratch.
+    static void sampleSort(vector<T>& data, int threads) {
+        size_t n = data.size();
+        if (threads <= 1 || n < (1 << 16)) {
+            radixSort(data.data(), n);
+            return;
+        }
+        const int OVERSAMPLE = 32;
+        int buckets = threads * 4;
+
+        vector<T> sample(buckets * OVERSAMPLE);
+        uint64_t rng = 0x9E3779B97F4A7C15ull;
+        for (T& x : sample) {
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            x = data[rng % n];
+        }
+        introSort(sample.data(), sample.data() + sample.size());
+        vector<T> splitters(buckets - 1);
+        for (int b = 1; b < buckets; b++)
+            splitters[b - 1] = sample[b * OVERSAMPLE];
+
+        auto bucketOf = [&](T x) {
+            return (int)(upper_bound(splitters.begin(), splitters.end(), x) - splitters.begin());
+        };
+        auto chunkBegin = [&](int t) { return n * t / threads; };
+
+        vector<vector<size_t>> offsets(threads, vector<size_t>(buckets, 0));
+        parallelFor(threads, [&](int t) {
+            for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); i++)
+                offsets[t][bucketOf(data[i])]++;
+        });
+
+        vector<size_t> bucketStart(buckets + 1, 0);
+        size_t sum = 0;
+        for (int b = 0; b < buckets; b++) {
+            bucketStart[b] = sum;
+            for (int t = 0; t < threads; t++) {
+                size_t c = offsets[t][b];
+                offsets[t][b] = sum;
+                sum += c;
+            }
+        }
+        bucketStart[buckets] = n;
+
+        vector<T> out(n);
+        parallelFor(threads, [&](int t) {
+            vector<size_t>& pos = offsets[t];
+            for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); i++)
+                out[pos[bucketOf(data[i])]++] = data[i];
+        });
+
+        atomic<int> next(0);
+        parallelFor(threads, [&](int) {
+            for (int b = next++; b < buckets; b = next++) {
+                size_t begin = bucketStart[b];
+                radixSort(out.data() + begin, data.data() + begin, bucketStart[b + 1] - begin);
+            }
+        });
+        data.swap(out);
+    }
+
+    static void sort(vector<T>& data, int threads) {
+        if (data.size() < RADIX_CUTOFF)
+            introSort(data.data(), data.data() + data.size());
+        else if (threads > 1 && data.size() >= (1 << 20))
+            sampleSort(data, threads);
+        else
+            radixSort(data.data(), data.size());
+    }
+};
+
+template <typename T>
+void sortIntegers(vector<T>& data, int threads = 1) {
+    IntegerSorter<T>::sort(data, threads);
+}
+
+// Dense n x n distance matrix for all-pairs work. The size is padded up to a
+// multiple of BLOCK with INF entries so every tile is full, and the buffer is
+// 32-byte aligned, which keeps every row aligned for AVX2 loads.
+class DistanceMatrix {
+private:
+    int n, padded;
+    vector<int> storage;
+    int* base;
+
+public:
+    static constexpr int BLOCK = 64;
+    static constexpr int INF_DIST = INT_MAX / 2; // INF_DIST + INF_DIST still fits in an int
+
+    DistanceMatrix(int size) : n(size), padded((size + BLOCK - 1) / BLOCK * BLOCK) {
+        storage.assign((size_t)padded * padded + 8, INF_DIST);
+        uintptr_t addr = (uintptr_t)storage.data();
+        base = storage.data() + ((32 - addr % 32) % 32) / sizeof(int);
         for (int i = 0; i < n; i++)
-            cout << arr[i] << " ";
-        cout << endl;
+            at(i, i) = 0;
+    }
+
+    DistanceMatrix(const DistanceMatrix&) = delete;
+    DistanceMatrix& operator=(const DistanceMatrix&) = delete;
+    DistanceMatrix(DistanceMatrix&&) = default;
+    DistanceMatrix& operator=(DistanceMatrix&&) = default;
+
+    // Parallel arcs keep the lightest weight.
+    static DistanceMatrix fromSparse(const SparseGraph& g) {
+        DistanceMatrix d(g.n);
+        for (int u = 0; u < g.n; u++)
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++)
+                if (g.targets[e] != u)
+                    d.at(u, g.targets[e]) = min(d.at(u, g.targets[e]), g.weights[e]);
+        return d;
+    }
+
+    int size() const { return n; }
+    int paddedSize() const { return padded; }
+    int* row(int i) { return base + (size_t)i * padded; }
+    const int* row(int i) const { return base + (size_t)i * padded; }
+    int& at(int i, int j) { return row(i)[j]; }
+    int at(int i, int j) const { return row(i)[j]; }
+};
+
+// Blocked Floyd-Warshall and min-plus products over DistanceMatrix. Every k-block
+// round updates the diagonal tile, then its row and column tiles, then all other
+// tiles as an independent min-plus product processed one block row per task.
+// Weights must be non-negative and below INF_DIST: with INF_DIST = INT_MAX / 2 a
+// sum never overflows, and min() against an entry <= INF_DIST saturates at INF.
+class AllPairsShortestPaths {
+private:
+    static constexpr int B = DistanceMatrix::BLOCK;
+    static constexpr int INF_DIST = DistanceMatrix::INF_DIST;
+
+    // C = min(C, A (x) B) with k outermost, so C may alias A or B (diagonal,
+    // row and column tiles of the current round).
+    static void tileDependent(int* c, const int* a, const int* b, int stride) {
+        for (int k = 0; k < B; k++) {
+            const int* bk = b + (size_t)k * stride;
+            for (int i = 0; i < B; i++) {
+                int aik = a[(size_t)i * stride + k];
+                if (aik >= INF_DIST)
+                    continue;
+                int* ci = c + (size_t)i * stride;
+                for (int j = 0; j < B; j++)
+                    ci[j] = min(ci[j], aik + bk[j]);
+            }
+        }
+    }
+
+    static void tileIndependent(int* c, const int* a, const int* b, int stride) {
+        for (int i = 0; i < B; i++) {
+            int* ci = c + (size_t)i * stride;
+            const int* ai = a + (size_t)i * stride;
+            for (int k = 0; k < B; k++) {
+                int aik = ai[k];
+                if (aik >= INF_DIST)
+                    continue;
+                const int* bk = b + (size_t)k * stride;
+                for (int j = 0; j < B; j++)
+                    ci[j] = min(ci[j], aik + bk[j]);
+            }
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("avx2")))
+    static void tileDependentAvx2(int* c, const int* a, const int* b, int stride) {
+        for (int k = 0; k < B; k++) {
+            const int* bk = b + (size_t)k * stride;
+            for (int i = 0; i < B; i++) {
+                int aik = a[(size_t)i * stride + k];
+                if (aik >= INF_DIST)
+                    continue;
+                __m256i av = _mm256_set1_epi32(aik);
+                int* ci = c + (size_t)i * stride;
+                for (int j = 0; j < B; j += 8) {
+                    __m256i sum = _mm256_add_epi32(av, _mm256_load_si256((const __m256i*)(bk + j)));
+                    __m256i cur = _mm256_load_si256((const __m256i*)(ci + j));
+                    _mm256_store_si256((__m256i*)(ci + j), _mm256_min_epi32(cur, sum));
+                }
+            }
+        }
+    }
+
+    // The whole 64-int output row lives in eight ymm registers across the k loop.
+    __attribute__((target("avx2")))
+    static void tileIndependentAvx2(int* c, const int* a, const int* b, int stride) {
+        for (int i = 0; i < B; i++) {
+            int* ci = c + (size_t)i * stride;
+            const int* ai = a + (size_t)i * stride;
+            __m256i acc[B / 8];
+            for (int v = 0; v < B / 8; v++)
+                acc[v] = _mm256_load_si256((const __m256i*)(ci + 8 * v));
+            for (int k = 0; k < B; k++) {
+                int aik = ai[k];
+                if (aik >= INF_DIST)
+                    continue;
+                __m256i av = _mm256_set1_epi32(aik);
+                const int* bk = b + (size_t)k * stride;
+                for (int v = 0; v < B / 8; v++) {
+                    __m256i sum = _mm256_add_epi32(av, _mm256_load_si256((const __m256i*)(bk + 8 * v)));
+                    acc[v] = _mm256_min_epi32(acc[v], sum);
+                }
+            }
+            for (int v = 0; v < B / 8; v++)
+                _mm256_store_si256((__m256i*)(ci + 8 * v), acc[v]);
+        }
+    }
+
+    static bool hasAvx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
     }
+#else
+    static void tileDependentAvx2(int* c, const int* a, const int* b, int stride) {
+        tileDependent(c, a, b, stride);
+    }
+
+    static void tileIndependentAvx2(int* c, const int* a, const int* b, int stride) {
+        tileIndependent(c, a, b, stride);
+    }
+
+    static bool hasAvx2() {
+        return false;
+    }
+#endif
 
-    void sort(vector<int>& arr) {
-        int n = arr.size();
-        for (int i = 0; i < n - 1; i++) {
-            int minIndex = i;
-            for (int j = i + 1; j < n; j++) {
-                if (arr[j] < arr[minIndex])
-                    minIndex = j;
+    static void dependent(int* c, const int* a, const int* b, int stride, bool simd) {
+        if (simd)
+            tileDependentAvx2(c, a, b, stride);
+        else
+            tileDependent(c, a, b, stride);
+    }
+
+    static void independent(int* c, const int* a, const int* b, int stride, bool simd) {
+        if (simd)
+            tileIndependentAvx2(c, a, b, stride);
+        else
+            tileIndependent(c, a, b, stride);
+    }
+
+public:
+    // Textbook triple loop; kept as the reference and benchmark baseline.
+    static void floydWarshallNaive(DistanceMatrix& d) {
+        int n = d.size();
+        for (int k = 0; k < n; k++)
+            for (int i = 0; i < n; i++) {
+                int dik = d.at(i, k);
+                if (dik >= INF_DIST)
+                    continue;
+                for (int j = 0; j < n; j++)
+                    d.at(i, j) = min(d.at(i, j), dik + d.at(k, j));
             }
-            swap(arr[i], arr[minIndex]);
+    }
+
+    static void floydWarshall(DistanceMatrix& d, int threads, bool useSimd = true) {
+        int stride = d.paddedSize();
+        int blocks = stride / B;
+        bool simd = useSimd && hasAvx2();
+        auto tile = [&](int bi, int bj) { return d.row(bi * B) + bj * B; };
+
+        for (int kb = 0; kb < blocks; kb++) {
+            int* diag = tile(kb, kb);
+            dependent(diag, diag, diag, stride, simd);
+
+            int lineThreads = min(threads, 2 * (blocks - 1));
+            parallelFor(max(1, lineThreads), [&](int t) {
+                for (int x = t; x < 2 * blocks; x += max(1, lineThreads)) {
+                    int other = x / 2;
+                    if (other == kb)
+                        continue;
+                    if (x % 2 == 0) {
+                        int* rowTile = tile(kb, other);
+                        dependent(rowTile, diag, rowTile, stride, simd);
+                    } else {
+                        int* colTile = tile(other, kb);
+                        dependent(colTile, colTile, diag, stride, simd);
+                    }
+                }
+            });
+
+            atomic<int> next(0);
+            parallelFor(min(threads, blocks), [&](int) {
+                for (int bi = next++; bi < blocks; bi = next++) {
+                    if (bi == kb)
+                        continue;
+                    for (int bj = 0; bj < blocks; bj++)
+                        if (bj != kb)
+                            independent(tile(bi, bj), tile(bi, kb), tile(kb, bj), stride, simd);
+                }
+            });
         }
     }
+
+    // (a (x) b)[i][j] = min_k a[i][k] + b[k][j]; squaring a distance matrix
+    // doubles the number of hops its entries account for.
+    static DistanceMatrix minPlusProduct(const DistanceMatrix& a, const DistanceMatrix& b, int threads) {
+        DistanceMatrix c(a.size());
+        for (int i = 0; i < a.size(); i++)
+            c.at(i, i) = INF_DIST;
+        int stride = c.paddedSize();
+        int blocks = stride / B;
+        bool simd = hasAvx2();
+        atomic<int> next(0);
+        parallelFor(min(threads, blocks), [&](int) {
+            for (int bi = next++; bi < blocks; bi = next++)
+                for (int bk = 0; bk < blocks; bk++)
+                    for (int bj = 0; bj < blocks; bj++)
+                        independent(c.row(bi * B) + bj * B, a.row(bi * B) + bk * B,
+                                    b.row(bk * B) + bj * B, stride, simd);
+        });
+        return c;
+    }
 };
 
 class Graph {
@@ -49,6 +631,10 @@ public:
         cout << "--------------------------\n";
         cout << "Enter number of vertices: ";
         cin >> n;
+        while (n < 1 || n > 10) {
+            cout << "The adjacency matrix holds 1 to 10 vertices (use Option 8 for larger graphs): ";
+            cin >> n;
+        }
         cout << "Is the graph directed? (1 for yes, 0 for no): ";
         cin >> isDirected;
         cout << "Is the graph weighted? (1 for yes, 0 for no): ";
@@ -76,12 +662,44 @@ public:
             if (u == -1)
                 break;
             cin >> v >> w;
+            if (u < 0 || u >= n || v < 0 || v >= n) {
+                cout << "Invalid edge: vertices must be between 0 and " << n - 1 << ".\n";
+                continue;
+            }
             graph[u][v] = isWeighted ? w : 1;
             if (!isDirected)
                 graph[v][u] = isWeighted ? w : 1;
         }
     }
 
+    SparseGraph toSparse() {
+        vector<WeightedEdge> edges;
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                if (graph[i][j] != 0)
+                    edges.push_back({i, j, graph[i][j]});
+        return SparseGraph::fromEdges(n, edges, true);
+    }
+
+    DistanceMatrix toDistanceMatrix() {
+        DistanceMatrix d(n);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                if (i != j && graph[i][j] != 0)
+                    d.at(i, j) = graph[i][j];
+        return d;
+    }
+
+    // Undirected view of the matrix: each pair once, directed arcs as undirected edges.
+    vector<WeightedEdge> toEdgeList() {
+        vector<WeightedEdge> edges;
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                if (graph[i][j] != 0 && (isDirected || i < j))
+                    edges.push_back({i, j, graph[i][j]});
+        return edges;
+    }
+
     void prims() {
         int cost[10][10];
         for (int i = 0; i < n; i++)
@@ -109,8 +727,10 @@ public:
                 }
             }
 
-            if (v == -1)
+            if (v == -1) {
+                cout << "Graph is disconnected: only the tree containing vertex 0 was built.\n";
                 break;
+            }
 
             int u = from[v];
             visited[v] = 1;
@@ -187,16 +807,616 @@ public:
     }
 };
 
+// Parallel delta-stepping SSSP (Meyer & Sanders). Vertices are kept in buckets of
+// width delta; light edges (w <= delta) of a bucket are relaxed repeatedly until the
+// bucket stops refilling, heavy edges once when it is settled. Each worker writes
+// relaxation requests into its own buffers, partitioned by the owning worker of the
+// target vertex, so dist/from are only ever written by one thread.
+class DeltaStepping {
+private:
+    struct Request {
+        int v, from;
+        long long d;
+    };
+
+    const SparseGraph& g;
+    long long delta;
+    int threads;
+    vector<long long> dist;
+    vector<int> from;
+    vector<long long> pulledDist;
+    vector<vector<int>> buckets;
+    vector<vector<vector<Request>>> requests; // [producer][owner]
+    vector<vector<int>> improved;            // [owner]
+
+    void insert(int v) {
+        size_t b = dist[v] / delta;
+        if (b >= buckets.size())
+            buckets.resize(b + 1);
+        buckets[b].push_back(v);
+    }
+
+    void relax(const vector<int>& frontier, bool light) {
+        long long work = 0;
+        for (int u : frontier)
+            work += g.offsets[u + 1] - g.offsets[u];
+        int active = work < 4096 ? 1 : threads;
+
+        parallelFor(active, [&](int t) {
+            size_t begin = frontier.size() * t / active;
+            size_t end = frontier.size() * (t + 1) / active;
+            vector<vector<Request>>& out = requests[t];
+            for (size_t i = begin; i < end; i++) {
+                int u = frontier[i];
+                long long du = dist[u];
+                for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                    int w = g.weights[e];
+                    if ((w <= delta) != light)
+                        continue;
+                    int v = g.targets[e];
+                    if (du + w < dist[v])
+                        out[v % threads].push_back({v, u, du + w});
+                }
+            }
+        });
+
+        parallelFor(active, [&](int t) {
+            for (int owner = t; owner < threads; owner += active) {
+                for (int p = 0; p < active; p++) {
+                    for (const Request& r : requests[p][owner]) {
+                        if (r.d < dist[r.v]) {
+                            dist[r.v] = r.d;
+                            from[r.v] = r.from;
+                            improved[owner].push_back(r.v);
+                        }
+                    }
+                    requests[p][owner].clear();
+                }
+            }
+        });
+
+        for (vector<int>& list : improved) {
+            for (int v : list)
+                insert(v);
+            list.clear();
+        }
+    }
+
+public:
+    DeltaStepping(const SparseGraph& graph, long long bucketWidth, int threadCount)
+        : g(graph), delta(max(1LL, bucketWidth)), threads(max(1, threadCount)) {
+        requests.assign(threads, vector<vector<Request>>(threads));
+        improved.assign(threads, vector<int>());
+    }
+
+    // A bucket width around maxWeight / averageDegree keeps buckets small without
+    // making the light-edge phases degenerate into Bellman-Ford.
+    static long long suggestDelta(const SparseGraph& graph) {
+        if (graph.n == 0 || graph.targets.empty())
+            return 1;
+        long long avgDegree = max<long long>(1, (long long)graph.targets.size() / graph.n);
+        return max<long long>(1, graph.maxWeight() / avgDegree);
+    }
+
+    vector<long long> run(int src) {
+        dist.assign(g.n, LINF);
+        from.assign(g.n, -1);
+        pulledDist.assign(g.n, LINF);
+        buckets.clear();
+        vector<int> settledIn(g.n, -1);
+
+        dist[src] = 0;
+        insert(src);
+
+        for (size_t i = 0; i < buckets.size(); i++) {
+            vector<int> settled;
+            while (!buckets[i].empty()) {
+                vector<int> pulled;
+                pulled.swap(buckets[i]);
+
+                // Drop entries that moved to an earlier bucket or were already
+                // expanded with their current distance.
+                vector<int> frontier;
+                for (int v : pulled) {
+                    if ((size_t)(dist[v] / delta) != i || dist[v] >= pulledDist[v])
+                        continue;
+                    pulledDist[v] = dist[v];
+                    frontier.push_back(v);
+                    if (settledIn[v] != (int)i) {
+                        settledIn[v] = (int)i;
+                        settled.push_back(v);
+                    }
+                }
+                relax(frontier, true);
+            }
+            relax(settled, false);
+        }
+        return dist;
+    }
+
+    const vector<int>& predecessors() const {
+        return from;
+    }
+};
+
+void printShortestPaths(const vector<long long>& dist, const vector<int>& from, int src) {
+    cout << "Shortest paths from source vertex " << src << ":\n";
+    for (int i = 0; i < (int)dist.size(); i++) {
+        if (dist[i] >= LINF) {
+            cout << "To " << i << ": No path\n";
+            continue;
+        }
+
+        cout << "To " << i << " (Cost: " << dist[i] << "): ";
+        vector<int> path;
+        for (int j = i; j != -1; j = from[j])
+            path.push_back(j);
+        reverse(path.begin(), path.end());
+        for (int j : path)
+            cout << j << (j == i ? "\n" : " -> ");
+    }
+}
+
+void runDeltaStepping(const SparseGraph& sg) {
+    if (sg.n == 0) {
+        cout << "The graph has no vertices.\n";
+        return;
+    }
+    for (int w : sg.weights) {
+        if (w < 0) {
+            cout << "Delta-stepping requires non-negative edge weights.\n";
+            return;
+        }
+    }
+
+    long long delta;
+    int threads;
+    cout << "Enter bucket width delta (0 for automatic): ";
+    cin >> delta;
+    if (delta <= 0)
+        delta = DeltaStepping::suggestDelta(sg);
+    cout << "Enter number of threads (0 for all cores): ";
+    cin >> threads;
+    if (threads <= 0)
+        threads = defaultThreadCount();
+
+    DeltaStepping solver(sg, delta, threads);
+    vector<long long> dist = solver.run(0);
+    if (sg.n <= 20) {
+        printShortestPaths(dist, solver.predecessors(), 0);
+    } else {
+        int reachable = 0;
+        long long farthest = 0;
+        for (long long d : dist)
+            if (d < LINF) {
+                reachable++;
+                farthest = max(farthest, d);
+            }
+        cout << "Reached " << reachable << " of " << sg.n << " vertices from 0, farthest at distance "
+             << farthest << ".\n";
+    }
+
+    vector<int> from;
+    vector<long long> reference = dijkstraSparse(sg, 0, from);
+    cout << "Delta = " << delta << ", threads = " << threads << ", "
+         << (dist == reference ? "matches" : "DIFFERS FROM") << " sequential Dijkstra.\n";
+}
+
+struct SpanningForest {
+    vector<WeightedEdge> edges;
+    long long totalWeight = 0;
+    int components = 0;
+};
+
+// Disjoint sets with union by size and path halving.
+class UnionFind {
+private:
+    vector<int> parent;
+    vector<int> size;
+
+public:
+    UnionFind(int n) : parent(n), size(n, 1) {
+        for (int i = 0; i < n; i++)
+            parent[i] = i;
+    }
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // Root lookup without path compression; safe to call from several threads
+    // while no unite() is running.
+    int findConst(int x) const {
+        while (parent[x] != x)
+            x = parent[x];
+        return x;
+    }
+
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return false;
+        if (size[a] < size[b])
+            swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+};
+
+// All three engines treat the edges as undirected and return a minimum spanning
+// forest: one tree per connected component, counted in SpanningForest::components.
+class MSTSolver {
+public:
+    static SpanningForest prim(int n, const vector<WeightedEdge>& edges) {
+        SparseGraph g = SparseGraph::fromEdges(n, edges, false);
+        SpanningForest forest;
+        vector<char> inTree(n, 0);
+        vector<long long> best(n, LINF);
+        vector<int> from(n, -1);
+        priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<pair<long long, int>>> pq;
+
+        for (int root = 0; root < n; root++) {
+            if (inTree[root])
+                continue;
+            forest.components++;
+            best[root] = 0;
+            pq.push({0, root});
+            while (!pq.empty()) {
+                int u = pq.top().second;
+                long long key = pq.top().first;
+                pq.pop();
+                if (inTree[u] || key != best[u])
+                    continue;
+                inTree[u] = 1;
+                if (from[u] != -1) {
+                    forest.edges.push_back({from[u], u, (int)key});
+                    forest.totalWeight += key;
+                }
+                for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                    int v = g.targets[e];
+                    if (!inTree[v] && g.weights[e] < best[v]) {
+                        best[v] = g.weights[e];
+                        from[v] = u;
+                        pq.push({best[v], v});
+                    }
+                }
+            }
+        }
+        return forest;
+    }
+
+    static SpanningForest kruskal(int n, vector<WeightedEdge> edges, int threads) {
+        parallelSort(edges, [](const WeightedEdge& a, const WeightedEdge& b) {
+            return a.w < b.w;
+        }, threads);
+
+        SpanningForest forest;
+        UnionFind uf(n);
+        forest.components = n;
+        for (const WeightedEdge& e : edges) {
+            if (forest.components == 1)
+                break;
+            if (uf.unite(e.u, e.v)) {
+                forest.edges.push_back(e);
+                forest.totalWeight += e.w;
+                forest.components--;
+            }
+        }
+        return forest;
+    }
+
+    // Each round every component picks its cheapest outgoing edge (ties broken by
+    // edge index so no cycle can form) and all picked edges are contracted.
+    // Candidates are published with an atomic min on a packed (weight, index) key.
+    static SpanningForest boruvka(int n, const vector<WeightedEdge>& edges, int threads) {
+        const uint64_t NONE = UINT64_MAX;
+        SpanningForest forest;
+        forest.components = n;
+        UnionFind uf(n);
+        vector<int> comp(n);
+        for (int i = 0; i < n; i++)
+            comp[i] = i;
+        vector<atomic<uint64_t>> cheapest(n);
+        size_t m = edges.size();
+
+        while (true) {
+            parallelFor(threads, [&](int t) {
+                for (size_t v = n * (size_t)t / threads; v < n * (size_t)(t + 1) / threads; v++)
+                    cheapest[v].store(NONE, memory_order_relaxed);
+            });
+
+            parallelFor(threads, [&](int t) {
+                for (size_t i = m * t / threads; i < m * (t + 1) / threads; i++) {
+                    int cu = comp[edges[i].u], cv = comp[edges[i].v];
+                    if (cu == cv)
+                        continue;
+                    uint64_t key = ((uint64_t)((uint32_t)edges[i].w ^ 0x80000000u) << 32) | i;
+                    for (int c : {cu, cv}) {
+                        uint64_t cur = cheapest[c].load(memory_order_relaxed);
+                        while (key < cur && !cheapest[c].compare_exchange_weak(cur, key, memory_order_relaxed)) {
+                        }
+                    }
+                }
+            });
+
+            bool merged = false;
+            for (int c = 0; c < n; c++) {
+                uint64_t key = cheapest[c].load(memory_order_relaxed);
+                if (key == NONE)
+                    continue;
+                const WeightedEdge& e = edges[key & 0xffffffffu];
+                if (uf.unite(e.u, e.v)) {
+                    forest.edges.push_back(e);
+                    forest.totalWeight += e.w;
+                    forest.components--;
+                    merged = true;
+                }
+            }
+            if (!merged)
+                break;
+
+            parallelFor(threads, [&](int t) {
+                for (size_t v = n * (size_t)t / threads; v < n * (size_t)(t + 1) / threads; v++)
+                    comp[v] = uf.findConst(v);
+            });
+        }
+        return forest;
+    }
+};
+
+void printForest(const string& name, const SpanningForest& forest) {
+    cout << name << ":\n";
+    if (forest.edges.size() <= 50)
+        for (const WeightedEdge& e : forest.edges)
+            cout << "Edge: " << e.u << " - " << e.v << " Weight: " << e.w << endl;
+    cout << "Minimum Cost of spanning forest: " << forest.totalWeight
+         << " (" << forest.components << (forest.components == 1 ? " tree)" : " trees)") << endl;
+}
+
+void runSpanningForest(int n, const vector<WeightedEdge>& edges) {
+    int threads = defaultThreadCount();
+
+    SpanningForest p = MSTSolver::prim(n, edges);
+    SpanningForest k = MSTSolver::kruskal(n, edges, threads);
+    SpanningForest b = MSTSolver::boruvka(n, edges, threads);
+
+    printForest("Prim (binary heap)", p);
+    printForest("Kruskal (union-find)", k);
+    printForest("Boruvka (parallel)", b);
+    if (p.totalWeight != k.totalWeight || k.totalWeight != b.totalWeight)
+        cout << "Warning: the MST engines disagree on the total weight.\n";
+}
+
+void runSort() {
+    cout << "Integer Sort\n";
+    cout << "--------------------------\n";
+    cout << "Enter number of elements: ";
+    int n;
+    cin >> n;
+    if (n < 0) {
+        cout << "Number of elements cannot be negative.\n";
+        return;
+    }
+    vector<long long> arr(n);
+    cout << "Enter elements:\n";
+    for (int i = 0; i < n; i++)
+        cin >> arr[i];
+
+    sortIntegers(arr, defaultThreadCount());
+
+    cout << "Sorted array:\n";
+    for (int i = 0; i < n; i++)
+        cout << arr[i] << " ";
+    cout << endl;
+}
+
+// Prints the matrix for small graphs, otherwise a summary, and checks the row
+// of vertex 0 against sequential Dijkstra.
+void runAllPairs(const SparseGraph& sg, DistanceMatrix d) {
+    search::Stopwatch timer;
+    int threads = defaultThreadCount();
+    AllPairsShortestPaths::floydWarshall(d, threads);
+    double ms = timer.elapsedMs();
+
+    if (d.size() <= 20) {
+        cout << "All-pairs shortest path distances:\n";
+        for (int i = 0; i < d.size(); i++) {
+            for (int j = 0; j < d.size(); j++) {
+                if (d.at(i, j) >= DistanceMatrix::INF_DIST)
+                    cout << "INF ";
+                else
+                    cout << d.at(i, j) << " ";
+            }
+            cout << endl;
+        }
+    } else {
+        long long reachable = 0;
+        int farthest = 0;
+        for (int i = 0; i < d.size(); i++)
+            for (int j = 0; j < d.size(); j++)
+                if (d.at(i, j) < DistanceMatrix::INF_DIST) {
+                    reachable++;
+                    farthest = max(farthest, d.at(i, j));
+                }
+        cout << reachable << " of " << (long long)d.size() * d.size()
+             << " ordered pairs connected, longest shortest path " << farthest << ".\n";
+    }
+
+    vector<int> from;
+    vector<long long> reference = dijkstraSparse(sg, 0, from);
+    bool matches = true;
+    for (int j = 0; j < d.size(); j++)
+        if (reference[j] >= LINF ? d.at(0, j) < DistanceMatrix::INF_DIST : d.at(0, j) != reference[j])
+            matches = false;
+    cout << "Blocked Floyd-Warshall on " << d.size() << " vertices with " << threads << " threads: " << ms
+         << " ms, row 0 " << (matches ? "matches" : "DIFFERS FROM") << " sequential Dijkstra.\n";
+}
+
+void runAllPairs(Graph* g) {
+    for (int i = 0; i < g->n; i++)
+        for (int j = 0; j < g->n; j++)
+            if (g->graph[i][j] < 0) {
+                cout << "All-pairs engine requires non-negative edge weights.\n";
+                return;
+            }
+    runAllPairs(g->toSparse(), g->toDistanceMatrix());
+}
+
+// The dense matrix needs 4 * n^2 bytes, so this caps it at 1 GiB.
+const int MAX_ALL_PAIRS_VERTICES = 16384;
+
+void runAllPairs(const SparseGraph& sg) {
+    if (sg.n == 0) {
+        cout << "The graph has no vertices.\n";
+        return;
+    }
+    if (sg.n > MAX_ALL_PAIRS_VERTICES) {
+        cout << "All-pairs needs a dense " << sg.n << " x " << sg.n << " matrix; at most "
+             << MAX_ALL_PAIRS_VERTICES << " vertices are supported.\n";
+        return;
+    }
+    for (int w : sg.weights) {
+        if (w < 0) {
+            cout << "All-pairs engine requires non-negative edge weights.\n";
+            return;
+        }
+    }
+    // Path lengths must stay below INF_DIST or they would read as unreachable.
+    if ((long long)sg.maxWeight() * (sg.n - 1) >= DistanceMatrix::INF_DIST) {
+        cout << "Edge weights are too large for the 32-bit distance matrix.\n";
+        return;
+    }
+    runAllPairs(sg, DistanceMatrix::fromSparse(sg));
+}
+
+// isDirected reports how the arcs were built: always for DIMACS, as answered
+// for edge lists.
+SparseGraph* loadGraphFromFile(bool& isDirected) {
+    string path;
+    int directed = 1;
+    cout << "Enter path of a DIMACS .gr file or a 'u v w' edge list: ";
+    cin >> path;
+    if (!GraphLoader::isDimacs(path)) {
+        cout << "Is the graph directed? (1 for yes, 0 for no): ";
+        cin >> directed;
+    }
+
+    SparseGraph* sg = new SparseGraph();
+    string error;
+    bool fromCache;
+    if (!GraphLoader::load(path, directed != 0, *sg, error, fromCache)) {
+        cout << "Could not load graph: " << error << "\n";
+        delete sg;
+        return nullptr;
+    }
+    cout << "Loaded " << sg->n << " vertices and " << sg->targets.size() << " arcs"
+         << (fromCache ? " from the binary cache.\n" : ".\n");
+    isDirected = directed != 0;
+    return sg;
+}
+
+// Keeps Dijkstra distances from one source current while batches of
+// "+ u v w" / "- u v" edge updates arrive, and checks each batch against a full
+// Dijkstra run on the updated graph.
+void runDynamicShortestPaths(const SparseGraph& sg, bool directed) {
+    for (int w : sg.weights) {
+        if (w < 0) {
+            cout << "Dynamic shortest paths require non-negative edge weights.\n";
+            return;
+        }
+    }
+
+    int src;
+    cout << "Enter source vertex (0 to " << sg.n - 1 << "): ";
+    cin >> src;
+    if (src < 0 || src >= sg.n) {
+        cout << "Invalid source vertex.\n";
+        return;
+    }
+
+    search::DynamicShortestPaths paths(sg.n, src);
+    for (int u = 0; u < sg.n; u++)
+        for (int e = sg.offsets[u]; e < sg.offsets[u + 1]; e++)
+            paths.addArc(u, sg.targets[e], sg.weights[e]);
+    paths.recompute();
+
+    while (true) {
+        int count;
+        cout << "Number of updates in the next batch (0 to stop): ";
+        cin >> count;
+        if (!cin || count <= 0)
+            break;
+        cout << "Enter " << count << " updates (+ u v w to insert, - u v to delete):\n";
+        vector<search::DynamicShortestPaths::Update> batch;
+        for (int i = 0; i < count; i++) {
+            char op;
+            int u, v, w = 0;
+            cin >> op >> u >> v;
+            if (op == '+')
+                cin >> w;
+            if (u < 0 || u >= sg.n || v < 0 || v >= sg.n || w < 0) {
+                cout << "Skipping invalid update " << op << " " << u << " " << v << "\n";
+                continue;
+            }
+            batch.push_back({u, v, w, op == '+'});
+            if (!directed)
+                batch.push_back({v, u, w, op == '+'});
+        }
+
+        search::Stopwatch timer;
+        long long touched = paths.apply(batch);
+        double incrementalMs = timer.elapsedMs();
+
+        timer.reset();
+        vector<WeightedEdge> arcs;
+        paths.forEachArc([&](int u, int v, int w) { arcs.push_back({u, v, w}); });
+        vector<int> from;
+        vector<long long> reference = dijkstraSparse(SparseGraph::fromEdges(sg.n, arcs, true), src, from);
+        double recomputeMs = timer.elapsedMs();
+
+        const vector<long long>& dist = paths.distances();
+        bool matches = true;
+        for (int v = 0; v < sg.n && matches; v++)
+            matches = (reference[v] == LINF) == (dist[v] == search::DynamicShortestPaths::UNREACHABLE) &&
+                      (reference[v] == LINF || reference[v] == dist[v]);
+
+        if (sg.n <= 20) {
+            for (int v = 0; v < sg.n; v++) {
+                cout << "  " << src << " -> " << v << ": ";
+                if (dist[v] == search::DynamicShortestPaths::UNREACHABLE)
+                    cout << "unreachable\n";
+                else
+                    cout << dist[v] << "\n";
+            }
+        }
+        cout << "Repaired distances touching " << touched << " of " << sg.n << " vertices in " << incrementalMs
+             << " ms (full Dijkstra " << recomputeMs << " ms), distances " << (matches ? "match" : "DIFFER") << ".\n";
+    }
+}
+
 int main() {
     Graph* g = nullptr;
+    SparseGraph* loaded = nullptr; // set by Option 8; takes over Options 5, 6 and 7
+    bool loadedDirected = true;
 
     while (true) {
         cout << "\n===== MENU =====\n";
-        cout << "1. Selection Sort\n";
+        cout << "1. Sort Integers\n";
         cout << "2. Create Graph & Display Adjacency Matrix\n";
         cout << "3. Apply Prim's Algorithm\n";
         cout << "4. Apply Dijkstra's Algorithm\n";
-        cout << "5. Exit\n";
+        cout << "5. Delta-Stepping Shortest Paths (parallel)\n";
+        cout << "6. Minimum Spanning Forest (Prim / Kruskal / Boruvka)\n";
+        cout << "7. All-Pairs Shortest Paths (blocked Floyd-Warshall)\n";
+        cout << "8. Load Weighted Graph from File\n";
+        cout << "9. Dynamic Shortest Paths (batched edge updates)\n";
+        cout << "10. Exit\n";
         cout << "Enter your choice: ";
 
         int choice;
@@ -204,10 +1424,13 @@ int main() {
 
         switch (choice) {
             case 1:
-                SelectionSort();
+                runSort();
                 break;
 
             case 2: {
+                delete g;
+                delete loaded;
+                loaded = nullptr;
                 g = new Graph();
                 g->readGraphByEdge();
                 g->printGraph();
@@ -229,8 +1452,57 @@ int main() {
                 break;
 
             case 5:
+                if (loaded != nullptr)
+                    runDeltaStepping(*loaded);
+                else if (g != nullptr)
+                    runDeltaStepping(g->toSparse());
+                else
+                    cout << "Please create (Option 2) or load (Option 8) a graph first.\n";
+                break;
+
+            case 6:
+                if (loaded != nullptr)
+                    runSpanningForest(loaded->n, loaded->toEdgeList());
+                else if (g != nullptr)
+                    runSpanningForest(g->n, g->toEdgeList());
+                else
+                    cout << "Please create (Option 2) or load (Option 8) a graph first.\n";
+                break;
+
+            case 7:
+                if (loaded != nullptr)
+                    runAllPairs(*loaded);
+                else if (g != nullptr)
+                    runAllPairs(g);
+                else
+                    cout << "Please create (Option 2) or load (Option 8) a graph first.\n";
+                break;
+
+            case 8: {
+                bool directed;
+                SparseGraph* sg = loadGraphFromFile(directed);
+                if (sg != nullptr) {
+                    delete loaded;
+                    loaded = sg;
+                    loadedDirected = directed;
+                }
+                break;
+            }
+
+            case 9:
+                if (loaded != nullptr) {
+                    runDynamicShortestPaths(*loaded, loadedDirected);
+                } else if (g != nullptr) {
+                    runDynamicShortestPaths(g->toSparse(), g->isDirected != 0);
+                } else {
+                    cout << "Please create (Option 2) or load (Option 8) a graph first.\n";
+                }
+                break;
+
+            case 10:
                 cout << "Exiting program.\n";
                 delete g; // free memory
+                delete loaded;
                 return 0;
 
             default:
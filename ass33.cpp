@@ -1,94 +1,64 @@
 #include<bits/stdc++.h>
+#include "search.hpp"
+#include "puzzle.hpp"
 using namespace std;
 
 int N; // Puzzle size (N x N)
 vector<vector<int>> goal; // Goal state
 
-vector<pair<int, int>> directions = {{-1,0},{1,0},{0,-1},{0,1}};
-vector<char> dirChar = {'U','D','L','R'};
+// Face value of each tile label (see puzzle.hpp), for printing.
+vector<int> faceValue;
 
-struct Puzzle {
-    vector<vector<int>> board;
-    int x, y; // position of 0 (blank)
-    int g, h, f;
-    string path;
-
-    Puzzle(vector<vector<int>> b, int g = 0, string path = "") : board(b), g(g), path(path) {
-        h = calcHeuristic();
-        f = g + h;
-        findBlank();
-    }
-
-    void findBlank() {
-        for (int i = 0; i < N; ++i)
-            for (int j = 0; j < N; ++j)
-                if (board[i][j] == 0) {
-                    x = i;
-                    y = j;
-                    return;
-                }
-    }
-
-    int calcHeuristic() const {
-        // Manhattan distance heuristic
-        int dist = 0;
-        unordered_map<int, pair<int, int>> goalPos;
-        
-        // Create a map of value to position in goal state
-        for (int i = 0; i < N; ++i)
-            for (int j = 0; j < N; ++j)
-                goalPos[goal[i][j]] = {i, j};
+// Cell of the goal's blank, which SlidingPuzzle needs for its solvability test.
+int goalBlankCell() {
+    for (int i = 0; i < N; ++i)
+        for (int j = 0; j < N; ++j)
+            if (goal[i][j] == 0) return i * N + j;
+    return N * N - 1;
+}
 
-        // Calculate Manhattan distance for each tile
-        for (int i = 0; i < N; ++i) {
-            for (int j = 0; j < N; ++j) {
-                if (board[i][j] != 0) {
-                    int gi = goalPos.at(board[i][j]).first;
-                    int gj = goalPos.at(board[i][j]).second;
-                    dist += abs(i - gi) + abs(j - gj);
-                }
+PuzzleBoard labelBoard(const vector<vector<int>>& board) {
+    map<int, int> labelOf;
+    faceValue.assign(N * N, 0);
+    int label = 0;
+    for (int i = 0; i < N; ++i)
+        for (int j = 0; j < N; ++j)
+            if (goal[i][j] != 0) {
+                labelOf[goal[i][j]] = ++label;
+                faceValue[label] = goal[i][j];
             }
-        }
-
-        return dist;
-    }
 
-    bool isGoal() const {
-        return board == goal;
-    }
+    PuzzleBoard b;
+    b.tiles.resize(N * N);
+    b.blank = 0;
+    for (int i = 0; i < N; ++i)
+        for (int j = 0; j < N; ++j) {
+            b.tiles[i * N + j] = board[i][j] == 0 ? 0 : labelOf[board[i][j]];
+            if (board[i][j] == 0) b.blank = i * N + j;
+        }
+    return b;
+}
 
-    string boardToString() const {
-        string s;
-        for (const auto& row : board)
-            for (int val : row)
-                s += to_string(val) + ",";
-        return s;
-    }
+void printState(const PuzzleBoard& b, int g, int h, const string& path) {
+    cout << "\nStep #" << g << " (f=" << g + h << ", g=" << g << ", h=" << h << ")\n";
+    cout << "Path: " << (path.empty() ? "Start" : path) << "\n";
+    cout << "Board:\n";
 
-    bool operator>(const Puzzle& other) const {
-        return f > other.f;
-    }
+    // Determine the width needed for proper alignment
+    int maxDigits = to_string(N*N-1).length();
 
-    void printState() const {
-        cout << "\nStep #" << g << " (f=" << f << ", g=" << g << ", h=" << h << ")\n";
-        cout << "Path: " << (path.empty() ? "Start" : path) << "\n";
-        cout << "Board:\n";
-        
-        // Determine the width needed for proper alignment
-        int maxDigits = to_string(N*N-1).length();
-        
-        for (const auto& row : board) {
-            for (int val : row) {
-                if (val == 0) {
-                    cout << string(maxDigits, ' ') << " ";
-                } else {
-                    cout << setw(maxDigits) << val << " ";
-                }
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            int val = b.tiles[i * N + j];
+            if (val == 0) {
+                cout << string(maxDigits, ' ') << " ";
+            } else {
+                cout << setw(maxDigits) << faceValue[val] << " ";
             }
-            cout << "\n";
         }
+        cout << "\n";
     }
-};
+}
 
 // Function to count inversions for solvability check
 int countInversions(const vector<vector<int>>& board) {
@@ -98,8 +68,8 @@ int countInversions(const vector<vector<int>>& board) {
             if (val != 0) linear.push_back(val);
     
     int inv = 0;
-    for (int i = 0; i < linear.size(); ++i)
-        for (int j = i + 1; j < linear.size(); ++j)
+    for (size_t i = 0; i < linear.size(); ++i)
+        for (size_t j = i + 1; j < linear.size(); ++j)
             if (linear[i] > linear[j]) inv++;
     
     return inv;
@@ -127,69 +97,542 @@ bool isSolvable(const vector<vector<int>>& start, const vector<vector<int>>& tar
     }
 }
 
-void solveAStar(const vector<vector<int>>& startBoard) {
+// Prints every expansion and every newly generated child as the search runs.
+template <typename Problem>
+struct SearchTrace {
+    const Problem& problem;
+    search::BestFirstSearch<Problem>& astar;
+    int stepCount = 0;
+
+    template <typename Node>
+    void expanded(const Node& node, int index) {
+        cout << "\nExploring state (Step " << ++stepCount << "):";
+        printState(problem.toBoard(node.state), node.g, node.h, SlidingPuzzle::pathString(astar.actionsTo(index)));
+    }
+
+    template <typename Node>
+    void generated(const Node& node, int) {
+        cout << "  Generated move: " << SlidingPuzzle::MOVES[node.action]
+             << " (f=" << node.g + node.h << ", g=" << node.g << ", h=" << node.h << ")\n";
+    }
+};
+
+// Problem is SlidingPuzzle or a PackedPuzzle<N> picked by main for the board size.
+// Greedy best-first is the same search ordered by h alone.
+template <typename Problem>
+void solveAStar(const Problem& problem, const vector<vector<int>>& startBoard, bool trace, bool greedy = false) {
     if (!isSolvable(startBoard, goal)) {
         cout << "\n This puzzle is not solvable!\n";
         cout << "The given initial configuration cannot be transformed into the goal configuration.\n";
         return;
     }
 
-    priority_queue<Puzzle, vector<Puzzle>, greater<Puzzle>> pq;
-    set<string> visited;
+    PuzzleBoard startLabels = labelBoard(startBoard);
+    typename Problem::State start = problem.fromBoard(startLabels);
+    search::BestFirstSearch<Problem> astar(problem);
 
-    Puzzle start(startBoard);
-    pq.push(start);
-    visited.insert(start.boardToString());
+    search::BestFirstOptions options;
+    // Safety limit to prevent infinite loops; untraced runs can afford far more.
+    options.maxExpansions = trace ? 100000 : 10000000;
+    if (greedy) options.gWeight = 0;
 
-    int stepCount = 0;
-    const int maxSteps = 100000; // Safety limit to prevent infinite loops
-
-    cout << "\nStarting A* Search...\n";
+    cout << (greedy ? "\nStarting Greedy Best-First Search...\n" : "\nStarting A* Search...\n");
     cout << "Initial state:\n";
-    start.printState();
+    printState(startLabels, 0, problem.heuristic(start), "");
+
+    search::SearchResult<typename Problem::State> result =
+        trace ? astar.run(start, options, SearchTrace<Problem>{problem, astar}) : astar.run(start, options);
+
+    if (result.found) {
+        cout << "\n Puzzle Solved Successfully!\n";
+        cout << "Total moves: " << result.cost << "\n";
+        cout << "Solution path: " << SlidingPuzzle::pathString(result.actions) << "\n";
+        if (!trace)
+            cout << "Expanded " << result.expanded << " states in " << fixed << setprecision(1) << result.elapsedMs
+                 << " ms (" << result.peakBytes / 1048576.0 << " MB)\n";
+    } else if (result.truncated) {
+        cout << "\n Warning: Search halted after " << options.maxExpansions << " steps.\n";
+        cout << "The puzzle might be too complex or the heuristic might not be strong enough.\n";
+    } else {
+        cout << "\nNo solution found within the explored state space.\n";
+    }
+}
+
+// Beam search: the best few states of each depth layer under a memory cap, for
+// boards too large for A* to hold in memory.
+template <typename Problem>
+void solveBeam(const Problem& problem, const vector<vector<int>>& startBoard) {
+    if (!isSolvable(startBoard, goal)) {
+        cout << "\n This puzzle is not solvable!\n";
+        cout << "The given initial configuration cannot be transformed into the goal configuration.\n";
+        return;
+    }
 
-    while (!pq.empty()) {
-        Puzzle current = pq.top();
-        pq.pop();
+    search::BeamOptions options;
+    size_t memoryMb;
+    cout << "\nBeam width (states kept per depth, e.g., 1000): ";
+    cin >> options.width;
+    cout << "Memory cap in MB (e.g., 256): ";
+    cin >> memoryMb;
+    options.maxBytes = memoryMb << 20;
+
+    PuzzleBoard startLabels = labelBoard(startBoard);
+    search::BeamSearch<Problem> beam(problem);
+
+    cout << "\nStarting Beam Search...\n";
+    search::SearchResult<typename Problem::State> result = beam.run(problem.fromBoard(startLabels), options);
+
+    if (result.found) {
+        cout << "\n Puzzle Solved Successfully!\n";
+        cout << "Total moves: " << result.cost << "\n";
+        cout << "Solution path: " << SlidingPuzzle::pathString(result.actions) << "\n";
+    } else if (result.truncated) {
+        cout << "\n Warning: Search halted at the " << memoryMb << " MB memory cap.\n";
+        cout << "A narrower beam or a larger cap may help.\n";
+    } else {
+        cout << "\nThe beam ran dry without reaching the goal; try a wider beam.\n";
+    }
+    cout << "Expanded " << result.expanded << " states in " << fixed << setprecision(1) << result.elapsedMs
+         << " ms (" << result.peakBytes / 1048576.0 << " MB)\n";
+    cout.unsetf(ios::fixed);
+}
 
-        if (current.isGoal()) {
-            cout << "\n Puzzle Solved Successfully!\n";
-            cout << "Total moves: " << current.g << "\n";
-            cout << "Solution path: " << current.path << "\n";
-            return;
+// Anytime A* (ARA*): a quick weighted solution first, then better ones with
+// proven bounds until the weight reaches 1 or the budget runs out.
+template <typename Problem>
+void solveAnytime(const Problem& problem, const vector<vector<int>>& startBoard) {
+    if (!isSolvable(startBoard, goal)) {
+        cout << "\n This puzzle is not solvable!\n";
+        cout << "The given initial configuration cannot be transformed into the goal configuration.\n";
+        return;
+    }
+
+    search::AnytimeOptions options;
+    long long nodeBudget;
+    cout << "\nInitial heuristic weight (e.g., 3): ";
+    cin >> options.initialWeight;
+    cout << "Weight decrease per pass (e.g., 0.5): ";
+    cin >> options.weightStep;
+    cout << "Time budget in ms (e.g., 1000): ";
+    cin >> options.timeLimitMs;
+    cout << "Expansion budget (-1 for none): ";
+    cin >> nodeBudget;
+    if (nodeBudget >= 0) options.maxExpansions = nodeBudget;
+    if (options.weightStep <= 0) options.weightStep = 0.5;
+
+    PuzzleBoard startLabels = labelBoard(startBoard);
+    search::AnytimeAStar<Problem> ara(problem);
+
+    cout << "\nStarting anytime A* search...\n";
+    cout << fixed << setprecision(2);
+    search::SearchResult<typename Problem::State> result =
+        ara.run(problem.fromBoard(startLabels), options, [](const search::AnytimeSolution& s) {
+            cout << "  Weight " << s.weight << ": " << s.cost << " moves, ";
+            if (s.bound == numeric_limits<double>::infinity())
+                cout << "no bound yet";
+            else
+                cout << "at most " << s.bound << "x optimal";
+            cout << " (" << s.expanded << " expansions, " << setprecision(1) << s.elapsedMs << " ms)\n"
+                 << setprecision(2);
+        });
+    cout.unsetf(ios::fixed);
+
+    if (!result.found) {
+        cout << "\nNo solution found within the budget.\n";
+        return;
+    }
+    cout << "\n Best solution: " << result.cost << " moves"
+         << (result.truncated ? " (budget exhausted before optimality was proven)" : " (optimal)") << "\n";
+    cout << "Solution path: " << SlidingPuzzle::pathString(result.actions) << "\n";
+    cout << "Expanded " << result.expanded << " states in " << fixed << setprecision(1) << result.elapsedMs
+         << " ms (" << result.peakBytes / 1048576.0 << " MB)\n";
+    cout.unsetf(ios::fixed);
+}
+
+// Disk-backed breadth-first sweep with delayed duplicate detection.
+//
+// Each layer is a file of sorted, fixed-width packed boards. Expanding a layer
+// fills an in-memory buffer with children, and every full buffer is sorted and
+// written out as a run. The runs are then merged together with the sorted files
+// of the current and previous layers. In an undirected space a child of depth d
+// lies at depth d-1, d or d+1, so whatever survives the merge is exactly layer
+// d+1. More than MERGE_FAN_IN runs are first merged in groups of that size, and
+// again, until one final merge can take them all, so open files and read
+// buffers stay bounded however many runs a layer makes. Every file is read and
+// written sequentially, and only the run buffer or one merge's read buffers are
+// ever in memory.
+template <int W>
+class FrontierSweep {
+public:
+    using Packed = array<uint64_t, W>;
+
+private:
+    const SlidingPuzzle& problem;
+    int cells, bits;
+    uint64_t mask;
+    size_t memoryBytes;
+    filesystem::path dir;
+    long long bytesRead = 0, bytesWritten = 0;
+    int runCounter = 0;
+
+    static constexpr size_t MERGE_FAN_IN = 64;
+
+    class RecordReader {
+    private:
+        FILE* f;
+        vector<Packed> buffer;
+        size_t pos = 0, len = 0;
+        long long& bytesRead;
+
+        void fill() {
+            len = fread(buffer.data(), sizeof(Packed), buffer.size(), f);
+            if (len < buffer.size() && ferror(f)) throw runtime_error("read failed");
+            bytesRead += len * sizeof(Packed);
+            pos = 0;
         }
 
-        if (++stepCount > maxSteps) {
-            cout << "\n Warning: Search halted after " << maxSteps << " steps.\n";
-            cout << "The puzzle might be too complex or the heuristic might not be strong enough.\n";
-            return;
+    public:
+        RecordReader(const filesystem::path& file, size_t records, long long& counter)
+            : f(fopen(file.string().c_str(), "rb")), buffer(records), bytesRead(counter) {
+            if (!f) throw runtime_error("cannot open " + file.string());
+            fill();
+        }
+        ~RecordReader() { fclose(f); }
+        RecordReader(const RecordReader&) = delete;
+        RecordReader& operator=(const RecordReader&) = delete;
+
+        bool valid() const { return pos < len; }
+        const Packed& head() const { return buffer[pos]; }
+        void next() {
+            if (++pos == len) fill();
         }
+    };
+
+    class RecordWriter {
+    private:
+        FILE* f;
+        vector<Packed> buffer;
+        long long& bytesWritten;
 
-        cout << "\nExploring state (Step " << stepCount << "):";
-        current.printState();
+    public:
+        long long count = 0;
 
-        for (int i = 0; i < 4; ++i) {
-            int newX = current.x + directions[i].first;
-            int newY = current.y + directions[i].second;
+        RecordWriter(const filesystem::path& file, size_t records, long long& counter)
+            : f(fopen(file.string().c_str(), "wb")), bytesWritten(counter) {
+            if (!f) throw runtime_error("cannot create " + file.string());
+            buffer.reserve(records);
+        }
+        // Normal-path callers close() to see write errors; the destructor only
+        // releases the file (on unwinding, say) and never throws.
+        ~RecordWriter() {
+            if (f) fclose(f);
+        }
+        RecordWriter(const RecordWriter&) = delete;
+        RecordWriter& operator=(const RecordWriter&) = delete;
 
-            if (newX >= 0 && newX < N && newY >= 0 && newY < N) {
-                auto newBoard = current.board;
-                swap(newBoard[current.x][current.y], newBoard[newX][newY]);
-                Puzzle next(newBoard, current.g + 1, current.path + dirChar[i]);
+        void write(const Packed& p) {
+            buffer.push_back(p);
+            count++;
+            if (buffer.size() == buffer.capacity()) flush();
+        }
+        void write(const Packed* p, size_t n) {
+            flush();
+            if (fwrite(p, sizeof(Packed), n, f) != n) throw runtime_error("write failed (disk full?)");
+            bytesWritten += n * sizeof(Packed);
+            count += n;
+        }
+        void flush() {
+            if (buffer.empty()) return;
+            if (fwrite(buffer.data(), sizeof(Packed), buffer.size(), f) != buffer.size())
+                throw runtime_error("write failed (disk full?)");
+            bytesWritten += buffer.size() * sizeof(Packed);
+            buffer.clear();
+        }
+        void close() {
+            flush();
+            FILE* file = f;
+            f = nullptr;
+            if (fclose(file) != 0) throw runtime_error("write failed (disk full?)");
+        }
+    };
+
+    // Streams the union of sorted runs in order, each record once.
+    class RunMerge {
+    private:
+        using HeapEntry = pair<Packed, int>;
+        vector<unique_ptr<RecordReader>> readers;
+        priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry>> heap;
+        bool haveLast = false;
+        Packed last{};
+
+    public:
+        RunMerge(const vector<filesystem::path>& runs, size_t records, long long& counter) {
+            for (const auto& r : runs) {
+                readers.push_back(make_unique<RecordReader>(r, records, counter));
+                if (readers.back()->valid()) heap.push({readers.back()->head(), int(readers.size()) - 1});
+            }
+        }
 
-                if (visited.find(next.boardToString()) == visited.end()) {
-                    pq.push(next);
-                    visited.insert(next.boardToString());
-                    
-                    // Optional: Print info about this new state
-                    cout << "  Generated move: " << dirChar[i] 
-                         << " (f=" << next.f << ", g=" << next.g << ", h=" << next.h << ")\n";
+        bool next(Packed& p) {
+            while (!heap.empty()) {
+                int r = heap.top().second;
+                p = heap.top().first;
+                heap.pop();
+                readers[r]->next();
+                if (readers[r]->valid()) heap.push({readers[r]->head(), r});
+                if (haveLast && p == last) continue;
+                last = p;
+                haveLast = true;
+                return true;
+            }
+            return false;
+        }
+    };
+
+    filesystem::path layerFile(int depth) const { return dir / ("layer-" + to_string(depth) + ".bin"); }
+
+    filesystem::path newRun() { return dir / ("run-" + to_string(runCounter++) + ".bin"); }
+
+    // Merges groups of MERGE_FAN_IN runs into single runs until at most
+    // MERGE_FAN_IN are left; returns the number of merge passes.
+    int cascadeRuns(vector<filesystem::path>& runs, size_t records) {
+        int passes = 0;
+        while (runs.size() > MERGE_FAN_IN) {
+            vector<filesystem::path> merged;
+            for (size_t i = 0; i < runs.size(); i += MERGE_FAN_IN) {
+                vector<filesystem::path> group(runs.begin() + i, runs.begin() + min(i + MERGE_FAN_IN, runs.size()));
+                if (group.size() == 1) {
+                    merged.push_back(group[0]);
+                    continue;
+                }
+                merged.push_back(newRun());
+                {
+                    RunMerge merge(group, records, bytesRead);
+                    RecordWriter out(merged.back(), records, bytesWritten);
+                    Packed p;
+                    while (merge.next(p)) out.write(p);
+                    out.close();
                 }
+                for (const auto& r : group) filesystem::remove(r);
             }
+            runs.swap(merged);
+            passes++;
         }
+        return passes;
+    }
+
+    // Sorts and dedups the buffer into a new run file, then empties it.
+    void spillRun(vector<Packed>& buffer, vector<filesystem::path>& runs) {
+        if (buffer.empty()) return;
+        sort(buffer.begin(), buffer.end());
+        buffer.erase(unique(buffer.begin(), buffer.end()), buffer.end());
+        runs.push_back(newRun());
+        RecordWriter run(runs.back(), 1, bytesWritten);
+        run.write(buffer.data(), buffer.size());
+        run.close();
+        buffer.clear();
+    }
+
+public:
+    // Width in bits of one packed cell, and how many 64-bit words a board needs.
+    static int bitsPerCell(int cells) {
+        int b = 1;
+        while ((1 << b) < cells) b++;
+        return b;
+    }
+    static int wordsNeeded(int cells) { return (cells * bitsPerCell(cells) + 63) / 64; }
+
+    FrontierSweep(const SlidingPuzzle& p, size_t memoryMb, const filesystem::path& scratch)
+        : problem(p), cells(p.size() * p.size()), bits(bitsPerCell(cells)), mask((uint64_t(1) << bits) - 1),
+          memoryBytes(max<size_t>(memoryMb, 1) << 20), dir(scratch) {
+        filesystem::create_directories(dir);
     }
 
-    cout << "\nNo solution found within the explored state space.\n";
+    ~FrontierSweep() {
+        error_code ec;
+        filesystem::remove_all(dir, ec);
+    }
+
+    Packed pack(const PuzzleBoard& b) const {
+        Packed p{};
+        for (int i = 0; i < cells; ++i) {
+            int bit = i * bits, word = bit / 64, offset = bit % 64;
+            p[word] |= uint64_t(b.tiles[i]) << offset;
+            if (offset + bits > 64) p[word + 1] |= uint64_t(b.tiles[i]) >> (64 - offset);
+        }
+        return p;
+    }
+
+    PuzzleBoard unpack(const Packed& p) const {
+        PuzzleBoard b;
+        b.tiles.resize(cells);
+        b.blank = 0;
+        for (int i = 0; i < cells; ++i) {
+            int bit = i * bits, word = bit / 64, offset = bit % 64;
+            uint64_t v = p[word] >> offset;
+            if (offset + bits > 64) v |= p[word + 1] << (64 - offset);
+            b.tiles[i] = uint8_t(v & mask);
+            if (b.tiles[i] == 0) b.blank = i;
+        }
+        return b;
+    }
+
+    long long diskBytesRead() const { return bytesRead; }
+    long long diskBytesWritten() const { return bytesWritten; }
+
+    // Sweeps out from start until a layer comes up empty or maxDepth is reached
+    // (negative for no limit). Returns the size of each layer; goalDepth is set
+    // to the layer holding target, or -1 if it was never reached.
+    vector<long long> run(const PuzzleBoard& start, const PuzzleBoard& target, int maxDepth, int& goalDepth) {
+        const Packed goalKey = pack(target);
+        const size_t runRecords = max<size_t>(memoryBytes / 2 / sizeof(Packed), 1);
+
+        vector<long long> layers;
+        {
+            RecordWriter first(layerFile(0), 1, bytesWritten);
+            first.write(pack(start));
+            first.close();
+        }
+        layers.push_back(1);
+        goalDepth = pack(start) == goalKey ? 0 : -1;
+
+        vector<Packed> buffer;
+        for (int depth = 0; maxDepth < 0 || depth < maxDepth; ++depth) {
+            search::Stopwatch timer;
+
+            // Expand layer depth into sorted runs of children.
+            vector<filesystem::path> runs;
+            buffer.reserve(runRecords);
+            {
+                RecordReader layer(layerFile(depth), max<size_t>(runRecords / 16, 1), bytesRead);
+                for (; layer.valid(); layer.next()) {
+                    problem.successors(unpack(layer.head()), [&](const PuzzleBoard& next, int, int) {
+                        buffer.push_back(pack(next));
+                        if (buffer.size() == runRecords) spillRun(buffer, runs);
+                    });
+                }
+            }
+            spillRun(buffer, runs);
+            vector<Packed>().swap(buffer);
+
+            // Merge the runs, dropping anything already in this or the previous layer.
+            // One merge holds MERGE_FAN_IN readers, the two layer readers and the writer.
+            size_t readRecords = max<size_t>(memoryBytes / (MERGE_FAN_IN + 3) / sizeof(Packed), 1);
+            size_t spilled = runs.size();
+            int cascades = cascadeRuns(runs, readRecords);
+            long long nextSize = 0;
+            {
+                RunMerge merge(runs, readRecords, bytesRead);
+                unique_ptr<RecordReader> previous;
+                if (depth > 0) previous = make_unique<RecordReader>(layerFile(depth - 1), readRecords, bytesRead);
+                RecordReader current(layerFile(depth), readRecords, bytesRead);
+                RecordWriter out(layerFile(depth + 1), readRecords, bytesWritten);
+
+                Packed p;
+                while (merge.next(p)) {
+                    if (previous) {
+                        while (previous->valid() && previous->head() < p) previous->next();
+                        if (previous->valid() && previous->head() == p) continue;
+                    }
+                    while (current.valid() && current.head() < p) current.next();
+                    if (current.valid() && current.head() == p) continue;
+
+                    if (goalDepth < 0 && p == goalKey) goalDepth = depth + 1;
+                    out.write(p);
+                }
+                out.close();
+                nextSize = out.count;
+            }
+
+            for (const auto& r : runs) filesystem::remove(r);
+            if (depth > 0) filesystem::remove(layerFile(depth - 1));
+
+            cout << "  Depth " << setw(3) << depth + 1 << ": " << setw(14) << nextSize << " states  (" << spilled
+                 << " runs, " << cascades << " extra merge passes, " << fixed << setprecision(1) << timer.elapsedMs()
+                 << " ms)\n";
+            cout.unsetf(ios::fixed);
+            if (nextSize == 0) break;
+            layers.push_back(nextSize);
+        }
+        return layers;
+    }
+};
+
+template <int W>
+void sweepWithWidth(const SlidingPuzzle& problem, const PuzzleBoard& start, const PuzzleBoard& target,
+                    size_t memoryMb, int maxDepth, const filesystem::path& scratch) {
+    search::Stopwatch timer;
+    search::resetPeakRss();
+    int goalDepth = -1;
+    vector<long long> layers;
+    long long bytesRead = 0, bytesWritten = 0;
+    {
+        FrontierSweep<W> sweep(problem, memoryMb, scratch);
+        layers = sweep.run(start, target, maxDepth, goalDepth);
+        bytesRead = sweep.diskBytesRead();
+        bytesWritten = sweep.diskBytesWritten();
+    }
+
+    long long total = 0;
+    cout << "\nDistance distribution from the initial board:\n";
+    cout << setw(7) << "Depth" << setw(16) << "States" << setw(18) << "Cumulative" << "\n";
+    for (size_t d = 0; d < layers.size(); ++d) {
+        total += layers[d];
+        cout << setw(7) << d << setw(16) << layers[d] << setw(18) << total << "\n";
+    }
+    cout << "Total states reached: " << total << "\n";
+    if (goalDepth >= 0)
+        cout << "Goal board reached at depth " << goalDepth << " (optimal number of moves).\n";
+    else
+        cout << "Goal board not reached" << (maxDepth >= 0 ? " within the depth limit.\n" : ".\n");
+    cout << fixed << setprecision(1);
+    cout << "Time: " << timer.elapsedMs() / 1000.0 << " s, disk read " << bytesRead / 1048576.0 << " MB, written "
+         << bytesWritten / 1048576.0 << " MB, peak RSS " << search::peakRssKb() / 1024.0 << " MB\n";
+    cout.unsetf(ios::fixed);
+}
+
+void solveDiskSweep(const vector<vector<int>>& startBoard) {
+    size_t memoryMb;
+    int maxDepth;
+    string scratch;
+    cout << "\nMemory budget for sorting in MB (e.g., 256): ";
+    cin >> memoryMb;
+    cout << "Maximum depth (-1 to sweep the whole reachable space): ";
+    cin >> maxDepth;
+    cout << "Scratch directory for layer files (. for a temporary directory): ";
+    cin >> scratch;
+
+    filesystem::path dir = scratch == "." ? filesystem::temp_directory_path() : filesystem::path(scratch);
+    dir /= "lp-sweep-" + to_string(chrono::steady_clock::now().time_since_epoch().count());
+
+    SlidingPuzzle problem(N, goalBlankCell());
+    PuzzleBoard start = labelBoard(startBoard);
+    PuzzleBoard target = labelBoard(goal);
+
+    cout << "\nStarting disk-backed breadth-first sweep in " << dir.string() << "...\n";
+    try {
+        switch (FrontierSweep<1>::wordsNeeded(N * N)) {
+        case 1: sweepWithWidth<1>(problem, start, target, memoryMb, maxDepth, dir); break;
+        case 2: sweepWithWidth<2>(problem, start, target, memoryMb, maxDepth, dir); break;
+        case 3: sweepWithWidth<3>(problem, start, target, memoryMb, maxDepth, dir); break;
+        case 4: sweepWithWidth<4>(problem, start, target, memoryMb, maxDepth, dir); break;
+        default: cout << "Error: boards larger than 6x6 are not supported by the sweep.\n";
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << "\n";
+    }
+}
+
+template <typename Problem>
+void solve(const Problem& problem, const vector<vector<int>>& startBoard, int mode) {
+    if (mode == 4)
+        solveAnytime(problem, startBoard);
+    else if (mode == 5)
+        solveAStar(problem, startBoard, false, true);
+    else if (mode == 6)
+        solveBeam(problem, startBoard);
+    else
+        solveAStar(problem, startBoard, mode != 3);
 }
 
 int main() {
@@ -233,7 +676,30 @@ int main() {
         return 1;
     }
 
-    solveAStar(startBoard);
+    int mode;
+    cout << "\nChoose a search mode:\n";
+    cout << "1. A* search (step-by-step trace)\n";
+    cout << "2. Disk-backed breadth-first sweep (distance distribution)\n";
+    cout << "3. A* search (solution and statistics only)\n";
+    cout << "4. Anytime A* (improving solutions under a time/expansion budget)\n";
+    cout << "5. Greedy best-first search (orders by heuristic only)\n";
+    cout << "6. Beam search (best states per depth, memory-capped)\n";
+    cout << "Enter your choice: ";
+    cin >> mode;
+
+    if (mode == 2) {
+        solveDiskSweep(startBoard);
+        return 0;
+    }
+
+    // The solvers are compiled once per common board size; other sizes use the
+    // runtime-sized problem.
+    switch (N) {
+    case 3: solve(PackedPuzzle<3>(goalBlankCell()), startBoard, mode); break;
+    case 4: solve(PackedPuzzle<4>(goalBlankCell()), startBoard, mode); break;
+    case 5: solve(PackedPuzzle<5>(goalBlankCell()), startBoard, mode); break;
+    default: solve(SlidingPuzzle(N, goalBlankCell()), startBoard, mode);
+    }
 
     return 0;
 }
\ No newline at end of file
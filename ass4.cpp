@@ -1,26 +1,1342 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <limits>
 #include <algorithm>
 #include <chrono>
-#include <limits>
 #include <queue>
-#include <set>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <iomanip>
+#include <random>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include <fstream>
+#include <cstdlib>
+#include <new>
+#include "search.hpp"
 
 using namespace std;
 using namespace chrono;
 
-struct QueensState {
+// Every operator new goes through these counters so the benchmark can report
+// allocations per run.
+static atomic<long long> allocationCount(0);
+static atomic<long long> allocatedBytes(0);
+
+// Kept out of line so the compiler never pairs an inlined free() with a call it
+// only knows as operator new.
+__attribute__((noinline)) void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    allocatedBytes.fetch_add(size, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// Fixed-width bitset of 64 * W bits for boards wider than one machine word.
+template <int W>
+struct WideMask {
+    uint64_t w[W];
+
+    WideMask operator|(const WideMask& o) const {
+        WideMask r;
+        for (int i = 0; i < W; ++i) r.w[i] = w[i] | o.w[i];
+        return r;
+    }
+
+    WideMask operator&(const WideMask& o) const {
+        WideMask r;
+        for (int i = 0; i < W; ++i) r.w[i] = w[i] & o.w[i];
+        return r;
+    }
+
+    WideMask operator^(const WideMask& o) const {
+        WideMask r;
+        for (int i = 0; i < W; ++i) r.w[i] = w[i] ^ o.w[i];
+        return r;
+    }
+
+    WideMask operator~() const {
+        WideMask r;
+        for (int i = 0; i < W; ++i) r.w[i] = ~w[i];
+        return r;
+    }
+};
+
+// Mask primitives, overloaded for a single word and for WideMask.
+inline uint64_t fullMask(uint64_t, int n) { return n >= 64 ? ~0ull : (1ull << n) - 1; }
+inline bool any(uint64_t m) { return m != 0; }
+inline uint64_t lowestBit(uint64_t m) { return m & (~m + 1); }
+inline int bitIndex(uint64_t m) { return __builtin_ctzll(m); }
+inline int popCount(uint64_t m) { return __builtin_popcountll(m); }
+inline uint64_t shiftUp(uint64_t m) { return m << 1; }
+inline uint64_t shiftDown(uint64_t m) { return m >> 1; }
+
+template <int W>
+WideMask<W> fullMask(const WideMask<W>&, int n) {
+    WideMask<W> r;
+    for (int i = 0; i < W; ++i) {
+        int bits = min(64, max(0, n - 64 * i));
+        r.w[i] = fullMask(uint64_t(0), bits);
+        if (bits == 0) r.w[i] = 0;
+    }
+    return r;
+}
+
+template <int W>
+bool any(const WideMask<W>& m) {
+    for (int i = 0; i < W; ++i)
+        if (m.w[i]) return true;
+    return false;
+}
+
+template <int W>
+WideMask<W> lowestBit(const WideMask<W>& m) {
+    WideMask<W> r = {};
+    for (int i = 0; i < W; ++i) {
+        if (m.w[i]) {
+            r.w[i] = lowestBit(m.w[i]);
+            break;
+        }
+    }
+    return r;
+}
+
+template <int W>
+int bitIndex(const WideMask<W>& m) {
+    for (int i = 0; i < W; ++i)
+        if (m.w[i]) return 64 * i + __builtin_ctzll(m.w[i]);
+    return -1;
+}
+
+template <int W>
+int popCount(const WideMask<W>& m) {
+    int c = 0;
+    for (int i = 0; i < W; ++i) c += __builtin_popcountll(m.w[i]);
+    return c;
+}
+
+template <int W>
+WideMask<W> shiftUp(const WideMask<W>& m) {
+    WideMask<W> r;
+    for (int i = W - 1; i > 0; --i) r.w[i] = (m.w[i] << 1) | (m.w[i - 1] >> 63);
+    r.w[0] = m.w[0] << 1;
+    return r;
+}
+
+template <int W>
+WideMask<W> shiftDown(const WideMask<W>& m) {
+    WideMask<W> r;
+    for (int i = 0; i < W - 1; ++i) r.w[i] = (m.w[i] >> 1) | (m.w[i + 1] << 63);
+    r.w[W - 1] = m.w[W - 1] >> 1;
+    return r;
+}
+
+// Row-by-row search with the occupied columns and both diagonal directions kept
+// as bitmasks: the free squares of a row are full & ~(cols | diag1 | diag2) and
+// are enumerated lowest bit first. diag1 shifts up and diag2 shifts down by one
+// square per row. A child whose next row has no free square is pruned before the
+// call (one-row forward checking), and the last row is counted by popcount.
+template <typename Mask>
+class BitboardSearch {
+private:
+    int n;
+    Mask full;
+    long long nodes;
     vector<int> queens;
-    int row;
-    int bound;
 
-    QueensState(int n) : queens(n, -1), row(0), bound(0) {}
+    Mask freeSquares(const Mask& cols, const Mask& d1, const Mask& d2) const {
+        return full & ~(cols | d1 | d2);
+    }
+
+    bool first(int row, Mask cols, Mask d1, Mask d2) {
+        if (row == n) return true;
+
+        Mask avail = freeSquares(cols, d1, d2);
+        while (any(avail)) {
+            Mask bit = lowestBit(avail);
+            avail = avail ^ bit;
+            nodes++;
+
+            Mask nc = cols | bit, nd1 = shiftUp(d1 | bit), nd2 = shiftDown(d2 | bit);
+            if (row + 1 < n && !any(freeSquares(nc, nd1, nd2))) continue;
+
+            queens[row] = bitIndex(bit);
+            if (first(row + 1, nc, nd1, nd2)) return true;
+        }
+        queens[row] = -1;
+        return false;
+    }
+
+    long long count(int row, Mask cols, Mask d1, Mask d2) {
+        Mask avail = freeSquares(cols, d1, d2);
+        if (row == n - 1) {
+            int c = popCount(avail);
+            nodes += c;
+            return c;
+        }
+
+        long long total = 0;
+        while (any(avail)) {
+            Mask bit = lowestBit(avail);
+            avail = avail ^ bit;
+            nodes++;
+
+            Mask nc = cols | bit, nd1 = shiftUp(d1 | bit), nd2 = shiftDown(d2 | bit);
+            if (!any(freeSquares(nc, nd1, nd2))) continue;
+            total += count(row + 1, nc, nd1, nd2);
+        }
+        return total;
+    }
+
+public:
+    BitboardSearch(int boardSize) : n(boardSize), nodes(0), queens(boardSize, -1) {
+        full = fullMask(Mask(), n);
+    }
+
+    bool findFirst(vector<int>& solution) {
+        nodes = 0;
+        if (n == 0 || !first(0, Mask(), Mask(), Mask())) return false;
+        solution = queens;
+        return true;
+    }
+
+    long long countAll() {
+        nodes = 0;
+        if (n == 0) return 1;
+        return count(0, Mask(), Mask(), Mask());
+    }
+
+    // Counts completions of a partial placement of rows 0 .. row - 1.
+    long long countFrom(int row, Mask cols, Mask d1, Mask d2) {
+        nodes = 0;
+        if (row == n) return 1;
+        return count(row, cols, d1, d2);
+    }
+
+    long long nodesExplored() const {
+        return nodes;
+    }
+};
+
+const int MAX_BITBOARD_N = 1024;
+
+// Instantiates the narrowest mask type that holds n bits and passes the search to fn.
+template <typename Fn>
+bool withBitboard(int n, Fn fn) {
+    if (n <= 64) { BitboardSearch<uint64_t> s(n); fn(s); }
+    else if (n <= 128) { BitboardSearch<WideMask<2>> s(n); fn(s); }
+    else if (n <= 256) { BitboardSearch<WideMask<4>> s(n); fn(s); }
+    else if (n <= MAX_BITBOARD_N) { BitboardSearch<WideMask<16>> s(n); fn(s); }
+    else return false;
+    return true;
+}
+
+// Counts all solutions for n <= 64 on a work-stealing pool. Row 0 only tries the
+// left half of the columns (mirror images are counted twice; an odd board's middle
+// column once). The first rows are expanded into prefix tasks, dealt round-robin
+// to per-worker deques; owners pop from the back and idle workers steal from the
+// front of another deque. While some worker is idle, a task with enough rows left
+// is split into its children instead of being searched, so the pool keeps
+// balancing itself down to the leaves.
+class ParallelQueensCounter {
+public:
+    struct WorkerStats {
+        long long tasks = 0;
+        long long steals = 0;
+        long long splits = 0;
+        long long nodes = 0;
+        long long solutions = 0;
+        double busyMs = 0;
+    };
+
+private:
+    struct Task {
+        int row;
+        uint64_t cols, d1, d2;
+        int weight;
+    };
+
+    struct WorkerQueue {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    static const int MIN_ROWS_TO_SPLIT = 6;
+
+    int n;
+    int threads;
+    uint64_t full;
+    vector<WorkerQueue> queues;
+    atomic<long long> pending;
+    atomic<int> idle;
+    vector<WorkerStats> stats;
+
+    void expand(const Task& t, vector<Task>& out) const {
+        uint64_t avail = full & ~(t.cols | t.d1 | t.d2);
+        while (avail) {
+            uint64_t bit = avail & (~avail + 1);
+            avail ^= bit;
+            out.push_back({t.row + 1, t.cols | bit, (t.d1 | bit) << 1, (t.d2 | bit) >> 1, t.weight});
+        }
+    }
+
+    bool take(int self, Task& task) {
+        {
+            lock_guard<mutex> guard(queues[self].lock);
+            if (!queues[self].tasks.empty()) {
+                task = queues[self].tasks.back();
+                queues[self].tasks.pop_back();
+                return true;
+            }
+        }
+        for (int k = 1; k < threads; ++k) {
+            WorkerQueue& victim = queues[(self + k) % threads];
+            lock_guard<mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                stats[self].steals++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker(int self) {
+        WorkerStats& st = stats[self];
+        BitboardSearch<uint64_t> search(n);
+        vector<Task> children;
+        bool isIdle = false;
+
+        while (pending.load() > 0) {
+            Task task;
+            if (!take(self, task)) {
+                if (!isIdle) {
+                    isIdle = true;
+                    idle++;
+                }
+                this_thread::yield();
+                continue;
+            }
+            if (isIdle) {
+                isIdle = false;
+                idle--;
+            }
+
+            auto start = high_resolution_clock::now();
+            st.tasks++;
+            if (idle.load() > 0 && n - task.row >= MIN_ROWS_TO_SPLIT) {
+                children.clear();
+                expand(task, children);
+                st.splits++;
+                st.nodes += children.size();
+                pending += children.size();
+                lock_guard<mutex> guard(queues[self].lock);
+                for (const Task& c : children) queues[self].tasks.push_back(c);
+            } else {
+                long long found = search.countFrom(task.row, task.cols, task.d1, task.d2);
+                st.solutions += found * task.weight;
+                st.nodes += search.nodesExplored();
+            }
+            st.busyMs += duration<double, milli>(high_resolution_clock::now() - start).count();
+            pending--;
+        }
+        if (isIdle) idle--;
+    }
+
+public:
+    ParallelQueensCounter(int boardSize, int threadCount)
+        : n(boardSize), threads(max(1, threadCount)), full(fullMask(uint64_t(0), boardSize)),
+          queues(max(1, threadCount)), pending(0), idle(0) {}
+
+    long long count() {
+        stats.assign(threads, WorkerStats());
+        if (n == 0) return 1;
+
+        vector<Task> frontier;
+        for (int col = 0; col < (n + 1) / 2; ++col) {
+            uint64_t bit = 1ull << col;
+            int weight = (n % 2 == 1 && col == n / 2) ? 1 : 2;
+            frontier.push_back({1, bit, bit << 1, bit >> 1, weight});
+        }
+
+        // Expand breadth-first until there are plenty of tasks per worker.
+        while (!frontier.empty() && frontier.size() < (size_t)threads * 16 &&
+               n - frontier[0].row >= MIN_ROWS_TO_SPLIT) {
+            vector<Task> next;
+            for (const Task& t : frontier) expand(t, next);
+            frontier.swap(next);
+        }
+
+        pending = frontier.size();
+        for (size_t i = 0; i < frontier.size(); ++i)
+            queues[i % threads].tasks.push_back(frontier[i]);
+
+        vector<thread> pool;
+        for (int t = 1; t < threads; ++t) pool.emplace_back(&ParallelQueensCounter::worker, this, t);
+        worker(0);
+        for (thread& t : pool) t.join();
+
+        long long total = 0;
+        for (const WorkerStats& st : stats) total += st.solutions;
+        return total;
+    }
+
+    const vector<WorkerStats>& workerStats() const {
+        return stats;
+    }
+};
+
+// QS4-style min-conflicts local search (Sosic & Gu). Queens are kept as a
+// permutation, queens[row] = col, so rows and columns never clash and only the
+// 2n - 1 diagonals of each direction carry conflict counts. Moves swap the columns
+// of two rows; the collision delta is evaluated in O(1) by updating the four
+// affected diagonal counters and undoing them when the move does not help.
+// Memory is five int arrays of about n entries.
+class MinConflictsSolver {
+private:
+    int n;
+    vector<int> queens;
+    vector<int> diagSum;  // row + col
+    vector<int> diagDiff; // row - col + n - 1
+    long long collisions;
+    long long steps;
+    mt19937_64 rng;
+
+    int randomBelow(int bound) {
+        return (int)(rng() % (uint64_t)bound);
+    }
+
+    void remove(int row) {
+        if (--diagSum[row + queens[row]] > 0) collisions--;
+        if (--diagDiff[row - queens[row] + n - 1] > 0) collisions--;
+    }
+
+    void add(int row) {
+        if (diagSum[row + queens[row]]++ > 0) collisions++;
+        if (diagDiff[row - queens[row] + n - 1]++ > 0) collisions++;
+    }
+
+    bool attacked(int row) const {
+        return diagSum[row + queens[row]] > 1 || diagDiff[row - queens[row] + n - 1] > 1;
+    }
+
+    void swapRows(int i, int j) {
+        remove(i);
+        remove(j);
+        swap(queens[i], queens[j]);
+        add(i);
+        add(j);
+    }
+
+    // Row by row, try a few random unplaced columns for one that is free on both
+    // diagonals; after too many failures the remaining rows stay random.
+    void greedyStart() {
+        for (int i = 0; i < n; ++i) queens[i] = i;
+        fill(diagSum.begin(), diagSum.end(), 0);
+        fill(diagDiff.begin(), diagDiff.end(), 0);
+        collisions = 0;
+
+        long long budget = 3 * (long long)n + 100;
+        int row = 0;
+        for (; row < n && budget > 0; ++row) {
+            int tries = 0;
+            while (budget > 0) {
+                int j = row + randomBelow(n - row);
+                budget--;
+                if (diagSum[row + queens[j]] == 0 && diagDiff[row - queens[j] + n - 1] == 0) {
+                    swap(queens[row], queens[j]);
+                    break;
+                }
+                if (++tries > 8) break;
+            }
+            add(row);
+        }
+        for (; row < n; ++row) {
+            swap(queens[row], queens[row + randomBelow(n - row)]);
+            add(row);
+        }
+    }
+
+public:
+    MinConflictsSolver(int boardSize, uint64_t seed = 20240601)
+        : n(boardSize), queens(boardSize), diagSum(max(1, 2 * boardSize - 1)),
+          diagDiff(max(1, 2 * boardSize - 1)), collisions(0), steps(0), rng(seed) {}
+
+    // Returns false when n has no solution or every restart exhausted its budget.
+    bool solve(long long maxStepsPerRestart = 0, int maxRestarts = 50) {
+        steps = 0;
+        if (n == 2 || n == 3) return false;
+        if (n == 1) {
+            queens[0] = 0;
+            return true;
+        }
+        if (maxStepsPerRestart <= 0) maxStepsPerRestart = 20 * (long long)n + 10000;
+
+        for (int restart = 0; restart < maxRestarts; ++restart) {
+            greedyStart();
+            vector<int> conflicted;
+            long long budget = maxStepsPerRestart;
+
+            while (collisions > 0 && budget > 0) {
+                if (conflicted.empty()) {
+                    for (int i = 0; i < n; ++i)
+                        if (attacked(i)) conflicted.push_back(i);
+                }
+                int pick = randomBelow((int)conflicted.size());
+                int i = conflicted[pick];
+                if (!attacked(i)) {
+                    conflicted[pick] = conflicted.back();
+                    conflicted.pop_back();
+                    continue;
+                }
+
+                int j = randomBelow(n);
+                if (j == i) continue;
+                long long before = collisions;
+                swapRows(i, j);
+                steps++;
+                budget--;
+                if (collisions >= before) {
+                    swapRows(i, j);
+                } else if (attacked(j)) {
+                    conflicted.push_back(j);
+                }
+            }
+            if (collisions == 0) return true;
+        }
+        return false;
+    }
+
+    const vector<int>& placement() const {
+        return queens;
+    }
+
+    long long stepsTaken() const {
+        return steps;
+    }
+};
+
+// Best-first branch and bound for n <= 64. A node stores only its own queen, a
+// parent index and the column/diagonal masks, so children cost O(1) to create
+// instead of copying the whole placement; the board is rebuilt from parent links
+// once a goal is reached. Every queen is placed on a free square, so the conflict
+// bound is always zero; nodes are ordered by rows left to place (updated in O(1)
+// from the parent) and children whose next row has no free square are pruned.
+class BestFirstQueens {
+private:
+    struct Node {
+        uint64_t cols, d1, d2;
+        int parent;
+        int col;
+        int row;
+        int bound;
+    };
+
+    struct Entry {
+        int bound;
+        int node;
+
+        bool operator>(const Entry& other) const {
+            if (bound != other.bound) return bound > other.bound;
+            return node < other.node; // newest first among equals
+        }
+    };
+
+    int n;
+    vector<int> columnOrder;
+    long long expanded;
+    size_t peakBytes;
+
+public:
+    BestFirstQueens(int boardSize, bool centreFirst)
+        : n(boardSize), columnOrder(boardSize), expanded(0), peakBytes(0) {
+        for (int i = 0; i < n; ++i) columnOrder[i] = i;
+        if (centreFirst) {
+            stable_sort(columnOrder.begin(), columnOrder.end(), [this](int a, int b) {
+                return abs(2 * a - (n - 1)) < abs(2 * b - (n - 1));
+            });
+        }
+    }
+
+    bool solve(vector<int>& solution) {
+        expanded = 0;
+        peakBytes = 0;
+        uint64_t full = fullMask(uint64_t(0), n);
+        search::Arena<Node> arena;
+        priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+
+        size_t root = arena.allocate();
+        arena[root] = {0, 0, 0, -1, -1, 0, n};
+        open.push({n, (int)root});
+
+        while (!open.empty()) {
+            int id = open.top().node;
+            open.pop();
+            expanded++;
+            Node cur = arena[id];
+
+            if (cur.row == n) {
+                solution.assign(n, -1);
+                for (int k = id; arena[k].parent != -1; k = arena[k].parent)
+                    solution[arena[k].row - 1] = arena[k].col;
+                return true;
+            }
+
+            uint64_t avail = full & ~(cur.cols | cur.d1 | cur.d2);
+            for (int col : columnOrder) {
+                uint64_t bit = 1ull << col;
+                if (!(avail & bit)) continue;
+
+                uint64_t nc = cur.cols | bit, nd1 = (cur.d1 | bit) << 1, nd2 = (cur.d2 | bit) >> 1;
+                if (cur.row + 1 < n && !(full & ~(nc | nd1 | nd2))) continue;
+
+                size_t child = arena.allocate();
+                arena[child] = {nc, nd1, nd2, id, col, cur.row + 1, cur.bound - 1};
+                open.push({cur.bound - 1, (int)child});
+            }
+            peakBytes = max(peakBytes, arena.bytes() + open.size() * sizeof(Entry));
+        }
+        return false;
+    }
+
+    long long nodesExpanded() const { return expanded; }
+    size_t peakMemoryBytes() const { return peakBytes; }
+};
+
+// Closed-form placements (the classic n mod 6 case analysis), 1-based columns
+// listed row by row:
+//   n mod 6 not 2 or 3: 2, 4, ..., then 1, 3, ...
+//   n mod 6 == 2:       2, 4, ..., then 3, 1, 7, 9, ..., 5
+//   n mod 6 == 3:       4, 6, ..., 2, then 5, 7, ..., 1, 3
+// forEach() emits (row, 0-based column) pairs without storing anything, so a
+// placement can be streamed straight to disk; build() and verify() are O(n).
+class ExplicitQueens {
+public:
+    template <typename Fn>
+    static bool forEach(int n, Fn emit) {
+        if (n < 1 || n == 2 || n == 3) return false;
+        int row = 0;
+        auto put = [&](int col) { emit(row++, col - 1); };
+        int r = n % 6;
+
+        if (r == 3) {
+            for (int c = 4; c <= n; c += 2) put(c);
+            put(2);
+            for (int c = 5; c <= n; c += 2) put(c);
+            put(1);
+            put(3);
+        } else if (r == 2) {
+            for (int c = 2; c <= n; c += 2) put(c);
+            put(3);
+            put(1);
+            for (int c = 7; c <= n; c += 2) put(c);
+            put(5);
+        } else {
+            for (int c = 2; c <= n; c += 2) put(c);
+            for (int c = 1; c <= n; c += 2) put(c);
+        }
+        return true;
+    }
+
+    static bool build(int n, vector<int>& queens) {
+        queens.assign(max(n, 0), -1);
+        return forEach(n, [&](int row, int col) { queens[row] = col; });
+    }
+
+    // Checks one queen per row and column and at most one per diagonal.
+    static bool verify(const vector<int>& queens) {
+        int n = queens.size();
+        vector<bool> col(n), sum(2 * n), diff(2 * n);
+        for (int row = 0; row < n; ++row) {
+            int c = queens[row];
+            if (c < 0 || c >= n || col[c] || sum[row + c] || diff[row - c + n]) return false;
+            col[c] = sum[row + c] = diff[row - c + n] = true;
+        }
+        return true;
+    }
+};
+
+// Buffered text writer for placements: one 0-based column per line, row order.
+// Callers close() to learn whether every byte reached the file; the destructor
+// only releases it.
+class PlacementWriter {
+private:
+    FILE* file;
+    vector<char> buffer;
+    size_t used = 0;
+    bool failed = false;
+
+    void flush() {
+        if (file && used && fwrite(buffer.data(), 1, used, file) != used) failed = true;
+        used = 0;
+    }
+
+public:
+    PlacementWriter(const string& path) : file(fopen(path.c_str(), "wb")), buffer(1 << 20) {}
+
+    ~PlacementWriter() {
+        if (file) fclose(file);
+    }
+
+    PlacementWriter(const PlacementWriter&) = delete;
+    PlacementWriter& operator=(const PlacementWriter&) = delete;
 
-    QueensState(const QueensState& other) : queens(other.queens), row(other.row), bound(other.bound) {}
+    bool isOpen() const { return file != nullptr; }
 
-    bool operator>(const QueensState& other) const {
-        return bound > other.bound;
+    // Flushes and closes the file; false if any write or the close failed.
+    bool close() {
+        flush();
+        FILE* f = file;
+        file = nullptr;
+        return f && fclose(f) == 0 && !failed;
+    }
+
+    void write(int col) {
+        if (buffer.size() - used < 16) flush();
+        char digits[12];
+        int len = 0;
+        do {
+            digits[len++] = char('0' + col % 10);
+            col /= 10;
+        } while (col > 0);
+        while (len > 0) buffer[used++] = digits[--len];
+        buffer[used++] = '\n';
+    }
+};
+
+// Finite-domain CSP over variables 0 .. V-1 with values 0 .. D-1 and binary
+// constraints. Domains are bitsets; removals are recorded on a trail and undone
+// by popping back to a mark, so nothing is copied per node. Search picks the
+// unassigned variable with the smallest domain (ties: most constraints), tries
+// its values in increasing order, and after each assignment applies forward
+// checking and, optionally, AC-3 over the arcs of the variables that changed.
+//
+// Constraints come in two forms. Difference constraints x - y not in S (all
+// different, queen diagonals, colouring) prune by direct bit removal: assigning
+// x = v removes v - s from y. Any other relation is a predicate allowed(x, y).
+class CSPEngine {
+public:
+    enum Propagation { FORWARD_CHECKING, ARC_CONSISTENCY };
+
+private:
+    struct Arc {
+        int from, to;
+        vector<int> offsets;                // to != value(from) + offset
+        function<bool(int, int)> allowed;   // allowed(value(from), value(to)), or empty
+    };
+
+    struct TrailEntry {
+        int var;
+        int word;          // -1 records an assignment
+        uint64_t bits;
+    };
+
+    int vars, values, words;
+    vector<uint64_t> domains;
+    vector<int> domainSize;
+    vector<int> assigned;
+    vector<Arc> arcs;
+    vector<vector<int>> arcsFrom;
+    vector<TrailEntry> trail;
+    vector<uint64_t> savedDomains;
+    vector<int> arcQueue;
+    vector<char> inQueue;
+    Propagation propagation;
+    long long nodes;
+    long long solutions;
+    long long solutionLimit;
+    vector<int> firstSolution;
+
+    uint64_t* domainOf(int var) { return &domains[(size_t)var * words]; }
+
+    bool contains(int var, int value) const {
+        return (domains[(size_t)var * words + value / 64] >> (value % 64)) & 1;
+    }
+
+    // Returns false when var's domain becomes empty.
+    bool removeValue(int var, int value) {
+        if (value < 0 || value >= values || !contains(var, value)) return true;
+        uint64_t& word = domains[(size_t)var * words + value / 64];
+        trail.push_back({var, value / 64, word});
+        word &= ~(1ull << (value % 64));
+        return --domainSize[var] > 0;
+    }
+
+    void assign(int var, int value) {
+        uint64_t* dom = domainOf(var);
+        for (int w = 0; w < words; ++w) {
+            uint64_t keep = (w == value / 64) ? (1ull << (value % 64)) : 0;
+            if (dom[w] != keep) {
+                trail.push_back({var, w, dom[w]});
+                dom[w] = keep;
+            }
+        }
+        domainSize[var] = 1;
+        trail.push_back({var, -1, 0});
+        assigned[var] = value;
+    }
+
+    void undo(size_t mark) {
+        while (trail.size() > mark) {
+            TrailEntry e = trail.back();
+            trail.pop_back();
+            if (e.word < 0) {
+                assigned[e.var] = -1;
+                continue;
+            }
+            uint64_t& word = domains[(size_t)e.var * words + e.word];
+            domainSize[e.var] += __builtin_popcountll(e.bits) - __builtin_popcountll(word);
+            word = e.bits;
+        }
+    }
+
+    template <typename Fn>
+    void forEachValue(int var, Fn fn) {
+        const uint64_t* dom = domainOf(var);
+        for (int w = 0; w < words; ++w)
+            for (uint64_t bits = dom[w]; bits; bits &= bits - 1)
+                fn(64 * w + __builtin_ctzll(bits));
+    }
+
+    bool forwardCheck(int var, int value) {
+        for (int a : arcsFrom[var]) {
+            const Arc& arc = arcs[a];
+            if (assigned[arc.to] >= 0) continue;
+            for (int off : arc.offsets)
+                if (!removeValue(arc.to, value + off)) return false;
+            if (arc.allowed) {
+                bool alive = true;
+                forEachValue(arc.to, [&](int b) {
+                    if (alive && !arc.allowed(value, b)) alive = removeValue(arc.to, b);
+                });
+                if (!alive) return false;
+            }
+        }
+        return true;
+    }
+
+    // Removes values of arc.to without support in arc.from; sets changed.
+    bool revise(const Arc& arc, bool& changed) {
+        changed = false;
+        if (!arc.allowed) {
+            // A value of `to` loses support only if every value of `from` forbids it,
+            // which needs |D(from)| <= |offsets|.
+            if (domainSize[arc.from] > (int)arc.offsets.size()) return true;
+            vector<int> fromValues;
+            forEachValue(arc.from, [&](int a) { fromValues.push_back(a); });
+            for (int off : arc.offsets) {
+                int b = fromValues[0] + off;
+                if (b < 0 || b >= values || !contains(arc.to, b)) continue;
+                bool forbiddenByAll = true;
+                for (size_t i = 1; i < fromValues.size() && forbiddenByAll; ++i)
+                    forbiddenByAll = find(arc.offsets.begin(), arc.offsets.end(), b - fromValues[i]) != arc.offsets.end();
+                if (forbiddenByAll) {
+                    changed = true;
+                    if (!removeValue(arc.to, b)) return false;
+                }
+            }
+            return true;
+        }
+
+        vector<int> unsupported;
+        forEachValue(arc.to, [&](int b) {
+            bool supported = false;
+            forEachValue(arc.from, [&](int a) {
+                if (!supported && arc.allowed(a, b) &&
+                    find(arc.offsets.begin(), arc.offsets.end(), b - a) == arc.offsets.end())
+                    supported = true;
+            });
+            if (!supported) unsupported.push_back(b);
+        });
+        for (int b : unsupported) {
+            changed = true;
+            if (!removeValue(arc.to, b)) return false;
+        }
+        return true;
+    }
+
+    // AC-3 seeded with the arcs leaving every unassigned variable.
+    bool arcConsistency() {
+        arcQueue.clear();
+        for (size_t a = 0; a < arcs.size(); ++a) {
+            inQueue[a] = assigned[arcs[a].to] < 0;
+            if (inQueue[a]) arcQueue.push_back(a);
+        }
+        for (size_t head = 0; head < arcQueue.size(); ++head) {
+            int a = arcQueue[head];
+            inQueue[a] = 0;
+            bool changed;
+            if (!revise(arcs[a], changed)) return false;
+            if (!changed) continue;
+            for (int next : arcsFrom[arcs[a].to]) {
+                if (!inQueue[next] && assigned[arcs[next].to] < 0) {
+                    inQueue[next] = 1;
+                    arcQueue.push_back(next);
+                }
+            }
+        }
+        return true;
+    }
+
+    int selectVariable() const {
+        int best = -1;
+        for (int v = 0; v < vars; ++v) {
+            if (assigned[v] >= 0) continue;
+            if (best == -1 || domainSize[v] < domainSize[best] ||
+                (domainSize[v] == domainSize[best] && arcsFrom[v].size() > arcsFrom[best].size()))
+                best = v;
+        }
+        return best;
+    }
+
+    bool search(int depth) {
+        int var = selectVariable();
+        if (var == -1) {
+            if (solutions++ == 0) firstSolution = assigned;
+            return solutions >= solutionLimit;
+        }
+
+        uint64_t* saved = &savedDomains[(size_t)depth * words];
+        copy(domainOf(var), domainOf(var) + words, saved);
+        for (int w = 0; w < words; ++w) {
+            for (uint64_t bits = saved[w]; bits; bits &= bits - 1) {
+                int value = 64 * w + __builtin_ctzll(bits);
+                nodes++;
+                size_t mark = trail.size();
+                assign(var, value);
+                bool ok = forwardCheck(var, value);
+                if (ok && propagation == ARC_CONSISTENCY) ok = arcConsistency();
+                if (ok && search(depth + 1)) return true;
+                undo(mark);
+            }
+        }
+        return false;
+    }
+
+    void addArc(int from, int to, vector<int> offsets, function<bool(int, int)> allowed) {
+        arcsFrom[from].push_back(arcs.size());
+        arcs.push_back({from, to, move(offsets), move(allowed)});
+        inQueue.push_back(0);
+    }
+
+public:
+    CSPEngine(int variableCount, int domainSize)
+        : vars(variableCount), values(domainSize), words((domainSize + 63) / 64),
+          domains((size_t)variableCount * words, 0), domainSize(variableCount, domainSize),
+          assigned(variableCount, -1), arcsFrom(variableCount),
+          savedDomains((size_t)(variableCount + 1) * words), propagation(FORWARD_CHECKING),
+          nodes(0), solutions(0), solutionLimit(1) {
+        for (int v = 0; v < vars; ++v)
+            for (int d = 0; d < values; ++d)
+                domains[(size_t)v * words + d / 64] |= 1ull << (d % 64);
+    }
+
+    // x - y must not be any of the listed differences.
+    void addDifferenceConstraint(int x, int y, const vector<int>& forbidden) {
+        vector<int> fromX, fromY;
+        for (int s : forbidden) {
+            fromX.push_back(-s);
+            fromY.push_back(s);
+        }
+        addArc(x, y, fromX, nullptr);
+        addArc(y, x, fromY, nullptr);
+    }
+
+    void addConstraint(int x, int y, function<bool(int, int)> allowed) {
+        addArc(x, y, {}, allowed);
+        addArc(y, x, {}, [allowed](int b, int a) { return allowed(a, b); });
+    }
+
+    // Fixes a variable before search (givens of a puzzle).
+    bool fixValue(int var, int value) {
+        for (int d = 0; d < values; ++d)
+            if (d != value && !removeValue(var, d)) return false;
+        trail.clear();
+        return true;
+    }
+
+    void setPropagation(Propagation p) {
+        propagation = p;
+    }
+
+    bool solve(vector<int>& assignment) {
+        if (count(1) == 0) return false;
+        assignment = firstSolution;
+        return true;
+    }
+
+    long long count(long long limit = numeric_limits<long long>::max()) {
+        nodes = 0;
+        solutions = 0;
+        solutionLimit = limit;
+        for (int v = 0; v < vars; ++v)
+            if (domainSize[v] == 0) return 0;
+        if (propagation == ARC_CONSISTENCY && !arcConsistency()) {
+            undo(0);
+            return 0;
+        }
+        search(0);
+        undo(0);
+        return solutions;
+    }
+
+    long long nodesExplored() const {
+        return nodes;
+    }
+};
+
+// Problems expressed as CSPEngine models.
+class CSPModels {
+public:
+    // One variable per row holding that row's column.
+    static CSPEngine nQueens(int n) {
+        CSPEngine csp(n, n);
+        for (int i = 0; i < n; ++i)
+            for (int j = i + 1; j < n; ++j)
+                csp.addDifferenceConstraint(i, j, {0, j - i, i - j});
+        return csp;
+    }
+
+    // Cell (r, c) is variable r * n + c; rows and columns are all-different.
+    static CSPEngine latinSquare(int n) {
+        CSPEngine csp(n * n, n);
+        for (int r = 0; r < n; ++r)
+            for (int c = 0; c < n; ++c)
+                for (int k = c + 1; k < n; ++k) {
+                    csp.addDifferenceConstraint(r * n + c, r * n + k, {0});
+                    csp.addDifferenceConstraint(c * n + r, k * n + r, {0});
+                }
+        return csp;
+    }
+
+    // Vertex labels of an adjacency list (the ass1 Graph layout) are mapped to
+    // variables in the order written to `vertexOfVar`.
+    static CSPEngine graphColoring(const unordered_map<int, vector<int>>& adjacency, int colors,
+                                   vector<int>& vertexOfVar) {
+        unordered_map<int, int> varOf;
+        vertexOfVar.clear();
+        auto index = [&](int vertex) {
+            auto it = varOf.find(vertex);
+            if (it != varOf.end()) return it->second;
+            varOf[vertex] = vertexOfVar.size();
+            vertexOfVar.push_back(vertex);
+            return (int)vertexOfVar.size() - 1;
+        };
+        vector<pair<int, int>> edges;
+        for (const auto& entry : adjacency)
+            for (int neighbor : entry.second)
+                if (entry.first < neighbor) edges.push_back({index(entry.first), index(neighbor)});
+        for (const auto& entry : adjacency) index(entry.first);
+
+        CSPEngine csp(vertexOfVar.size(), colors);
+        for (const auto& e : edges) csp.addDifferenceConstraint(e.first, e.second, {0});
+        return csp;
+    }
+};
+
+// Streams every solution for n <= 64 to a callback without storing them. Each
+// placement is a packed byte array (row -> column). With fundamentalOnly set, a
+// solution is emitted only if it is the lexicographically smallest of its images
+// under the 8 board symmetries, so each equivalence class appears exactly once;
+// since the mirror image starts with n - 1 - q[0], row 0 never needs a column
+// past the middle. The callback returns false to stop early.
+class SolutionEnumerator {
+private:
+    int n;
+    uint64_t full;
+    bool fundamentalOnly;
+    vector<uint8_t> queens;
+    vector<uint8_t> inverse;
+    long long found;
+    long long emitted;
+    bool stopped;
+
+    // Returns true when no symmetric image is smaller than the current placement.
+    // Every image is written element-wise in terms of q or its inverse, so the
+    // comparison usually stops at the first entry.
+    bool isCanonical() {
+        const uint8_t* q = queens.data();
+        uint8_t* inv = inverse.data();
+        int m = n - 1;
+        for (int r = 0; r < n; ++r) inv[q[r]] = (uint8_t)r;
+
+        for (int k = 1; k < 8; ++k) {
+            for (int x = 0; x < n; ++x) {
+                int t;
+                switch (k) {
+                    case 1: t = m - inv[x]; break;      // rotate 90
+                    case 2: t = m - q[m - x]; break;    // rotate 180
+                    case 3: t = inv[m - x]; break;      // rotate 270
+                    case 4: t = m - q[x]; break;        // mirror columns
+                    case 5: t = q[m - x]; break;        // mirror rows
+                    case 6: t = inv[x]; break;          // main diagonal
+                    default: t = m - inv[m - x]; break; // anti-diagonal
+                }
+                if (t != q[x]) {
+                    if (t < q[x]) return false;
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename Fn>
+    void dfs(int row, uint64_t cols, uint64_t d1, uint64_t d2, Fn& onSolution) {
+        if (row == n) {
+            found++;
+            if (fundamentalOnly && !isCanonical()) return;
+            emitted++;
+            if (!onSolution(queens.data(), n)) stopped = true;
+            return;
+        }
+        uint64_t avail = full & ~(cols | d1 | d2);
+        if (row == 0 && fundamentalOnly) avail &= fullMask(uint64_t(0), (n + 1) / 2);
+        while (avail && !stopped) {
+            uint64_t bit = avail & (~avail + 1);
+            avail ^= bit;
+            queens[row] = (uint8_t)__builtin_ctzll(bit);
+            dfs(row + 1, cols | bit, (d1 | bit) << 1, (d2 | bit) >> 1, onSolution);
+        }
+    }
+
+public:
+    SolutionEnumerator(int boardSize, bool fundamental)
+        : n(boardSize), full(fullMask(uint64_t(0), boardSize)), fundamentalOnly(fundamental),
+          queens(boardSize), inverse(boardSize), found(0), emitted(0), stopped(false) {}
+
+    template <typename Fn>
+    long long run(Fn onSolution) {
+        found = emitted = 0;
+        stopped = false;
+        if (n >= 1 && n <= 64) dfs(0, 0, 0, 0, onSolution);
+        return emitted;
+    }
+
+    long long solutionsVisited() const {
+        return found;
+    }
+};
+
+// Binary solution file: an 8-byte header ("NQS1", n, bytes-per-column code,
+// fundamental flag, reserved) followed by one fixed-size record per solution.
+// Boards up to 16 pack two columns per byte (high nibble first), larger ones use
+// one byte per column. Callers close() to learn whether every record reached the
+// file; the destructor only releases it.
+class SolutionFileWriter {
+private:
+    FILE* file;
+    int n;
+    bool nibbles;
+    vector<uint8_t> buffer;
+    size_t used = 0;
+    bool failed = false;
+
+    void flush() {
+        if (file && used && fwrite(buffer.data(), 1, used, file) != used) failed = true;
+        used = 0;
+    }
+
+public:
+    SolutionFileWriter(const string& path, int boardSize, bool fundamentalOnly)
+        : file(fopen(path.c_str(), "wb")), n(boardSize), nibbles(boardSize <= 16), buffer(1 << 20) {
+        if (!file) return;
+        uint8_t header[8] = {'N', 'Q', 'S', '1', (uint8_t)n, (uint8_t)(nibbles ? 1 : 2),
+                             (uint8_t)(fundamentalOnly ? 1 : 0), 0};
+        if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) failed = true;
+    }
+
+    ~SolutionFileWriter() {
+        if (file) fclose(file);
+    }
+
+    SolutionFileWriter(const SolutionFileWriter&) = delete;
+    SolutionFileWriter& operator=(const SolutionFileWriter&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    // False once a write has failed; enumeration can stop early.
+    bool good() const { return !failed; }
+
+    // Flushes and closes the file; false if any write or the close failed.
+    bool close() {
+        flush();
+        FILE* f = file;
+        file = nullptr;
+        return f && fclose(f) == 0 && !failed;
+    }
+
+    size_t recordBytes() const { return nibbles ? (n + 1) / 2 : n; }
+
+    void write(const uint8_t* placement) {
+        if (buffer.size() - used < recordBytes()) flush();
+        if (nibbles) {
+            for (int r = 0; r < n; r += 2)
+                buffer[used++] = (uint8_t)((placement[r] << 4) | (r + 1 < n ? placement[r + 1] : 0));
+        } else {
+            memcpy(&buffer[used], placement, n);
+            used += n;
+        }
+    }
+};
+
+// Knuth's Algorithm X with Dancing Links. All links live in parallel int arrays
+// indexed by node (0 is the root, 1 .. columns are the headers), so covering and
+// uncovering walk contiguous memory instead of chasing heap pointers. Primary
+// columns must be covered exactly once; secondary columns, left out of the root
+// list, at most once. Search branches on the primary column with fewest rows.
+class DancingLinks {
+private:
+    vector<int> left, right, up, down, column, rowOf;
+    vector<int> columnSize;
+    int primaryColumns;
+    int rows;
+    long long nodes;
+    long long solutions;
+    long long solutionLimit;
+    vector<int> partial;
+
+    void cover(int c) {
+        right[left[c]] = right[c];
+        left[right[c]] = left[c];
+        for (int i = down[c]; i != c; i = down[i]) {
+            for (int j = right[i]; j != i; j = right[j]) {
+                down[up[j]] = down[j];
+                up[down[j]] = up[j];
+                columnSize[column[j]]--;
+            }
+        }
+    }
+
+    void uncover(int c) {
+        for (int i = up[c]; i != c; i = up[i]) {
+            for (int j = left[i]; j != i; j = left[j]) {
+                columnSize[column[j]]++;
+                down[up[j]] = j;
+                up[down[j]] = j;
+            }
+        }
+        right[left[c]] = c;
+        left[right[c]] = c;
+    }
+
+    template <typename Fn>
+    bool search(Fn& onSolution) {
+        if (right[0] == 0) {
+            solutions++;
+            return !onSolution(partial) || solutions >= solutionLimit;
+        }
+
+        int best = right[0];
+        for (int c = right[best]; c != 0; c = right[c])
+            if (columnSize[c] < columnSize[best]) best = c;
+        if (columnSize[best] == 0) return false;
+
+        cover(best);
+        for (int r = down[best]; r != best; r = down[r]) {
+            nodes++;
+            partial.push_back(rowOf[r]);
+            for (int j = right[r]; j != r; j = right[j]) cover(column[j]);
+            bool stop = search(onSolution);
+            for (int j = left[r]; j != r; j = left[j]) uncover(column[j]);
+            partial.pop_back();
+            if (stop) {
+                uncover(best);
+                return true;
+            }
+        }
+        uncover(best);
+        return false;
+    }
+
+public:
+    DancingLinks(int primary, int secondary) : primaryColumns(primary), rows(0), nodes(0), solutions(0), solutionLimit(0) {
+        int headers = primary + secondary + 1;
+        left.resize(headers);
+        right.resize(headers);
+        up.resize(headers);
+        down.resize(headers);
+        column.resize(headers);
+        rowOf.assign(headers, -1);
+        columnSize.assign(headers, 0);
+        for (int c = 0; c < headers; ++c) {
+            up[c] = down[c] = column[c] = c;
+            left[c] = right[c] = c;
+        }
+        for (int c = 0; c <= primary; ++c) {
+            left[c] = c == 0 ? primary : c - 1;
+            right[c] = c == primary ? 0 : c + 1;
+        }
+    }
+
+    // Columns are 0-based: primaries first, then secondaries. Returns the row id.
+    int addRow(const vector<int>& columns) {
+        int first = -1;
+        for (int cIndex : columns) {
+            int c = cIndex + 1;
+            int node = left.size();
+            column.push_back(c);
+            rowOf.push_back(rows);
+            up.push_back(up[c]);
+            down.push_back(c);
+            down[up[c]] = node;
+            up[c] = node;
+            columnSize[c]++;
+            if (first == -1) {
+                left.push_back(node);
+                right.push_back(node);
+                first = node;
+            } else {
+                left.push_back(left[first]);
+                right.push_back(first);
+                right[left[first]] = node;
+                left[first] = node;
+            }
+        }
+        return rows++;
+    }
+
+    // Calls onSolution(rowIds) for each exact cover; returning false stops the
+    // search. Stops on its own after `limit` solutions.
+    template <typename Fn>
+    long long solve(Fn onSolution, long long limit = numeric_limits<long long>::max()) {
+        nodes = 0;
+        solutions = 0;
+        solutionLimit = limit;
+        partial.clear();
+        search(onSolution);
+        return solutions;
+    }
+
+    long long nodesExplored() const {
+        return nodes;
+    }
+
+    // N-Queens as exact cover: every rank and file exactly once (primary), every
+    // diagonal at most once (secondary). Row id r * n + c places a queen at (r, c).
+    static DancingLinks nQueens(int n) {
+        DancingLinks dlx(2 * n, 2 * (2 * n - 1));
+        for (int r = 0; r < n; ++r)
+            for (int c = 0; c < n; ++c)
+                dlx.addRow({r, n + c, 2 * n + r + c, 2 * n + (2 * n - 1) + (r - c + n - 1)});
+        return dlx;
     }
 };
 
@@ -30,12 +1346,25 @@ private:
     vector<int> solution;
     long long nodesExplored;
     bool solutionFound;
+    bool verbose;
+    bool countingAll;
+    long long solutionCount;
 
 public:
-    NQueensSolver(int boardSize) : n(boardSize), nodesExplored(0), solutionFound(false) {
+    NQueensSolver(int boardSize) : n(boardSize), nodesExplored(0), solutionFound(false), verbose(true),
+                                  countingAll(false), solutionCount(0) {
         solution.resize(n, -1);
     }
 
+    // With verbose off the solve methods print nothing; used by the benchmark.
+    void setVerbose(bool on) {
+        verbose = on;
+    }
+
+    long long getNodesExplored() const {
+        return nodesExplored;
+    }
+
     bool isSafe(const vector<int>& queens, int row, int col) {
         for (int i = 0; i < row; ++i) {
             if (queens[i] == col || 
@@ -59,20 +1388,8 @@ public:
         return conflicts;
     }
 
-    int calculateLowerBound(const QueensState& state) {
-        int conflicts = 0;
-        for (int i = 0; i < state.row; ++i) {
-            for (int j = i + 1; j < state.row; ++j) {
-                if (state.queens[i] == state.queens[j] || 
-                    abs(state.queens[i] - state.queens[j]) == abs(i - j)) {
-                    conflicts++;
-                }
-            }
-        }
-        return conflicts;
-    }
-
     void printBoard(const vector<int>& queens) {
+        if (!verbose) return;
         cout << "\nSolution Board: \n";
         cout << "+";
         for (int i = 0; i < n; ++i) {
@@ -103,7 +1420,7 @@ public:
         auto endTime = high_resolution_clock::now();
 
         auto duration = duration_cast<milliseconds>(endTime - startTime).count();
-        cout << "Backtracking: " << (solutionFound ? "Solution found" : "No solution") 
+        if (verbose) cout << "Backtracking: " << (solutionFound ? "Solution found" : "No solution") 
              << " in " << duration << " ms after exploring " << nodesExplored << " nodes.\n";
 
         if (solutionFound) {
@@ -132,44 +1449,188 @@ public:
         }
     }
 
-    bool solveBranchAndBound() {
+    bool solveBitboard() {
         nodesExplored = 0;
         solutionFound = false;
 
-        priority_queue<QueensState, vector<QueensState>, greater<QueensState>> pq;
+        auto startTime = high_resolution_clock::now();
+        bool supported = withBitboard(n, [&](auto& search) {
+            solutionFound = search.findFirst(solution);
+            nodesExplored = search.nodesExplored();
+        });
+        auto endTime = high_resolution_clock::now();
+
+        if (!supported) {
+            if (verbose) cout << "Bitboard: board sizes above " << MAX_BITBOARD_N << " are not supported.\n";
+            return false;
+        }
+
+        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        if (verbose) cout << "Bitboard: " << (solutionFound ? "Solution found" : "No solution")
+             << " in " << duration << " ms after exploring " << nodesExplored << " nodes.\n";
 
-        QueensState initialState(n);
-        pq.push(initialState);
+        if (solutionFound) {
+            printBoard(solution);
+            return true;
+        }
+        return false;
+    }
+
+    long long countSolutionsBitboard() {
+        long long total = 0;
+        nodesExplored = 0;
 
         auto startTime = high_resolution_clock::now();
+        bool supported = withBitboard(n, [&](auto& search) {
+            total = search.countAll();
+            nodesExplored = search.nodesExplored();
+        });
+        auto endTime = high_resolution_clock::now();
 
-        while (!pq.empty() && !solutionFound) {
-            QueensState current = pq.top();
-            pq.pop();
+        if (!supported) {
+            if (verbose) cout << "Bitboard: board sizes above " << MAX_BITBOARD_N << " are not supported.\n";
+            return -1;
+        }
 
-            nodesExplored++;
+        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        if (verbose) cout << "Bitboard count: " << total << " solutions in " << duration
+             << " ms after exploring " << nodesExplored << " nodes.\n";
+        return total;
+    }
 
-            if (current.row == n) {
-                solution = current.queens;
-                solutionFound = true;
-                break;
-            }
+    long long enumerateSolutions(const string& path, bool fundamentalOnly) {
+        if (n > 64) {
+            if (verbose) cout << "Enumeration: board sizes above 64 are not supported.\n";
+            return -1;
+        }
+        SolutionFileWriter writer(path, n, fundamentalOnly);
+        if (!writer.isOpen()) {
+            if (verbose) cout << "Could not open " << path << " for writing.\n";
+            return -1;
+        }
 
-            for (int col = 0; col < n; ++col) {
-                if (isSafe(current.queens, current.row, col)) {
-                    QueensState next = current;
-                    next.queens[next.row] = col;
-                    next.row++;
-                    next.bound = calculateLowerBound(next);
-                    pq.push(next);
+        SolutionEnumerator enumerator(n, fundamentalOnly);
+        auto startTime = high_resolution_clock::now();
+        long long written = enumerator.run([&](const uint8_t* placement, int) {
+            writer.write(placement);
+            return writer.good();
+        });
+        bool closed = writer.close();
+        auto endTime = high_resolution_clock::now();
+        nodesExplored = enumerator.solutionsVisited();
+        if (!closed) {
+            if (verbose) cout << "Enumeration: could not write " << path << " (disk full?).\n";
+            return -1;
+        }
+
+        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        if (verbose) cout << "Enumeration: " << written << (fundamentalOnly ? " fundamental" : "")
+             << " solutions (" << writer.recordBytes() << " bytes each) written to " << path
+             << " in " << duration << " ms.\n";
+        return written;
+    }
+
+    long long countSolutionsParallel(int threads) {
+        if (n > 64) {
+            if (verbose) cout << "Parallel count: board sizes above 64 are not supported.\n";
+            return -1;
+        }
+
+        ParallelQueensCounter counter(n, threads);
+        auto startTime = high_resolution_clock::now();
+        long long total = counter.count();
+        auto endTime = high_resolution_clock::now();
+
+        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        const vector<ParallelQueensCounter::WorkerStats>& stats = counter.workerStats();
+        nodesExplored = 0;
+        for (const ParallelQueensCounter::WorkerStats& st : stats) nodesExplored += st.nodes;
+        if (!verbose) return total;
+
+        cout << "Parallel count: " << total << " solutions in " << duration
+             << " ms on " << threads << " threads.\n";
+        cout << "  thread      tasks     steals     splits          nodes      solutions    busy ms\n";
+        for (size_t t = 0; t < stats.size(); ++t) {
+            cout << setw(8) << t << setw(11) << stats[t].tasks << setw(11) << stats[t].steals
+                 << setw(11) << stats[t].splits << setw(15) << stats[t].nodes
+                 << setw(15) << stats[t].solutions << setw(11) << fixed << setprecision(1)
+                 << stats[t].busyMs << "\n";
+        }
+        return total;
+    }
+
+    bool solveConstructive(const string& outputPath) {
+        auto startTime = high_resolution_clock::now();
+        solutionFound = ExplicitQueens::build(n, solution);
+        auto builtTime = high_resolution_clock::now();
+        bool valid = solutionFound && ExplicitQueens::verify(solution);
+        auto endTime = high_resolution_clock::now();
+
+        nodesExplored = solutionFound ? n : 0;
+        if (verbose) {
+            cout << "Constructive: " << (solutionFound ? "Solution built" : "No solution")
+                 << " in " << duration_cast<milliseconds>(builtTime - startTime).count() << " ms";
+            if (solutionFound)
+                cout << ", verified " << (valid ? "valid" : "INVALID") << " in "
+                     << duration_cast<milliseconds>(endTime - builtTime).count() << " ms";
+            cout << ".\n";
+        }
+
+        if (!solutionFound) return false;
+        if (n <= 30) printBoard(solution);
+
+        if (!outputPath.empty() && outputPath != "-") {
+            PlacementWriter writer(outputPath);
+            if (!writer.isOpen()) {
+                if (verbose) cout << "Could not open " << outputPath << " for writing.\n";
+            } else {
+                ExplicitQueens::forEach(n, [&](int, int col) { writer.write(col); });
+                if (!writer.close()) {
+                    if (verbose) cout << "Could not write the placement to " << outputPath << " (disk full?).\n";
+                    return false;
                 }
+                if (verbose) cout << "Placement written to " << outputPath << " (one column per row).\n";
             }
         }
+        return valid;
+    }
+
+    long long countSolutionsConstraintBacktracking() {
+        nodesExplored = 0;
+        solutionFound = false;
+        countingAll = true;
+        solutionCount = 0;
+
+        vector<int> queens(n, -1);
+        vector<bool> col_used(n, false);
+        vector<bool> diag1_used(2*n-1, false);
+        vector<bool> diag2_used(2*n-1, false);
 
+        auto startTime = high_resolution_clock::now();
+        constraintBacktrack(queens, 0, col_used, diag1_used, diag2_used);
         auto endTime = high_resolution_clock::now();
+        countingAll = false;
+
         auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        if (verbose) cout << "Constraint Backtracking count: " << solutionCount << " solutions in " << duration
+             << " ms after exploring " << nodesExplored << " nodes.\n";
+        return solutionCount;
+    }
+
+    bool solveDancingLinks() {
+        nodesExplored = 0;
+        DancingLinks dlx = DancingLinks::nQueens(n);
 
-        cout << "Branch and Bound: " << (solutionFound ? "Solution found" : "No solution") 
+        auto startTime = high_resolution_clock::now();
+        solutionFound = dlx.solve([&](const vector<int>& rows) {
+            for (int id : rows) solution[id / n] = id % n;
+            return false;
+        }, 1) > 0;
+        auto endTime = high_resolution_clock::now();
+        nodesExplored = dlx.nodesExplored();
+
+        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        if (verbose) cout << "Dancing Links: " << (solutionFound ? "Solution found" : "No solution")
              << " in " << duration << " ms after exploring " << nodesExplored << " nodes.\n";
 
         if (solutionFound) {
@@ -179,6 +1640,64 @@ public:
         return false;
     }
 
+    long long countSolutionsDancingLinks() {
+        DancingLinks dlx = DancingLinks::nQueens(n);
+
+        auto startTime = high_resolution_clock::now();
+        long long total = dlx.solve([](const vector<int>&) { return true; });
+        auto endTime = high_resolution_clock::now();
+        nodesExplored = dlx.nodesExplored();
+
+        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        if (verbose) cout << "Dancing Links count: " << total << " solutions in " << duration
+             << " ms after exploring " << nodesExplored << " nodes.\n";
+        return total;
+    }
+
+    bool solveGenericCSP() {
+        nodesExplored = 0;
+        CSPEngine csp = CSPModels::nQueens(n);
+
+        auto startTime = high_resolution_clock::now();
+        solutionFound = csp.solve(solution);
+        auto endTime = high_resolution_clock::now();
+        nodesExplored = csp.nodesExplored();
+
+        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        if (verbose) cout << "Generic CSP (MRV + forward checking): " << (solutionFound ? "Solution found" : "No solution")
+             << " in " << duration << " ms after exploring " << nodesExplored << " nodes.\n";
+
+        if (solutionFound) {
+            printBoard(solution);
+            return true;
+        }
+        return false;
+    }
+
+    bool solveMinConflicts() {
+        MinConflictsSolver local(n);
+
+        auto startTime = high_resolution_clock::now();
+        solutionFound = local.solve();
+        auto endTime = high_resolution_clock::now();
+        nodesExplored = local.stepsTaken();
+
+        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        if (verbose) cout << "Min-Conflicts: " << (solutionFound ? "Solution found" : "No solution")
+             << " in " << duration << " ms after " << local.stepsTaken() << " repair steps.\n";
+
+        if (solutionFound) {
+            solution = local.placement();
+            if (n <= 30) printBoard(solution);
+            return true;
+        }
+        return false;
+    }
+
+    bool solveBranchAndBound() {
+        return runBestFirst("Branch and Bound", false);
+    }
+
     bool solveConstraintBacktracking() {
         nodesExplored = 0;
         solutionFound = false;
@@ -193,7 +1712,7 @@ public:
         auto endTime = high_resolution_clock::now();
 
         auto duration = duration_cast<milliseconds>(endTime - startTime).count();
-        cout << "Constraint Backtracking: " << (solutionFound ? "Solution found" : "No solution") 
+        if (verbose) cout << "Constraint Backtracking: " << (solutionFound ? "Solution found" : "No solution") 
              << " in " << duration << " ms after exploring " << nodesExplored << " nodes.\n";
 
         if (solutionFound) {
@@ -208,6 +1727,10 @@ public:
                              vector<bool>& diag1_used,
                              vector<bool>& diag2_used) {
         if (row == n) {
+            if (countingAll) {
+                solutionCount++;
+                return;
+            }
             solution = queens;
             solutionFound = true;
             return;
@@ -236,82 +1759,233 @@ public:
         }
     }
 
+    // Centre-first column ordering, as the CSP heuristic always used.
     bool solveCSPWithBranchAndBound() {
+        return runBestFirst("CSP with Branch & Bound", true);
+    }
+
+    bool runBestFirst(const string& name, bool centreFirst) {
         nodesExplored = 0;
         solutionFound = false;
 
-        priority_queue<QueensState, vector<QueensState>, greater<QueensState>> pq;
-        set<vector<int>> visited;
-
-        QueensState initialState(n);
-        pq.push(initialState);
-
-        int bestBound = numeric_limits<int>::max();
+        if (n > 64) {
+            if (verbose) cout << name << ": board sizes above 64 are not supported.\n";
+            return false;
+        }
 
+        BestFirstQueens search(n, centreFirst);
         auto startTime = high_resolution_clock::now();
+        solutionFound = search.solve(solution);
+        auto endTime = high_resolution_clock::now();
+        nodesExplored = search.nodesExpanded();
 
-        while (!pq.empty() && !solutionFound) {
-            QueensState current = pq.top();
-            pq.pop();
-
-            nodesExplored++;
+        double seconds = duration<double>(endTime - startTime).count();
+        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+        if (verbose) cout << name << ": " << (solutionFound ? "Solution found" : "No solution")
+             << " in " << duration << " ms after exploring " << nodesExplored << " nodes ("
+             << (long long)(nodesExplored / max(seconds, 1e-9)) << " nodes/s, peak memory "
+             << search.peakMemoryBytes() / 1024 << " KB).\n";
 
-            if (visited.find(current.queens) != visited.end() || current.bound > bestBound) {
-                continue;
-            }
+        if (solutionFound) {
+            printBoard(solution);
+            return true;
+        }
+        return false;
+    }
+};
 
-            visited.insert(current.queens);
+// Runs every strategy over a range of board sizes with warmup and repeated timed
+// runs at steady_clock (nanosecond) resolution. Each strategy has a size cap past
+// which it is skipped, so one range can cover both the exhaustive searches and
+// the large-N solvers.
+class SolverBenchmark {
+public:
+    struct Strategy {
+        string name;
+        int maxN;
+        function<long long(int)> run; // returns nodes explored
+    };
+
+    struct Result {
+        string strategy;
+        int n;
+        int reps;
+        double medianNs, p95Ns, minNs, meanNs;
+        long long nodes;
+        double nodesPerSec;
+        double allocationsPerRun;
+        double bytesPerRun;
+        long long peakRssKb;
+    };
+
+    static vector<Strategy> strategies(int threads) {
+        auto solve = [](bool (NQueensSolver::*method)()) {
+            return [method](int n) {
+                NQueensSolver solver(n);
+                solver.setVerbose(false);
+                (solver.*method)();
+                return solver.getNodesExplored();
+            };
+        };
+        return {
+            {"backtracking", 24, solve(&NQueensSolver::solveBacktracking)},
+            {"constraint_backtracking", 26, solve(&NQueensSolver::solveConstraintBacktracking)},
+            {"branch_and_bound", 26, solve(&NQueensSolver::solveBranchAndBound)},
+            {"csp_branch_and_bound", 26, solve(&NQueensSolver::solveCSPWithBranchAndBound)},
+            {"bitboard", 28, solve(&NQueensSolver::solveBitboard)},
+            {"generic_csp", 60, solve(&NQueensSolver::solveGenericCSP)},
+            {"dancing_links", 60, solve(&NQueensSolver::solveDancingLinks)},
+            {"min_conflicts", 10000000, solve(&NQueensSolver::solveMinConflicts)},
+            {"constructive", 100000000, [](int n) {
+                 NQueensSolver solver(n);
+                 solver.setVerbose(false);
+                 solver.solveConstructive("-");
+                 return solver.getNodesExplored();
+             }},
+            {"bitboard_count", 15, [](int n) {
+                 NQueensSolver solver(n);
+                 solver.setVerbose(false);
+                 solver.countSolutionsBitboard();
+                 return solver.getNodesExplored();
+             }},
+            {"constraint_backtracking_count", 14, [](int n) {
+                 NQueensSolver solver(n);
+                 solver.setVerbose(false);
+                 solver.countSolutionsConstraintBacktracking();
+                 return solver.getNodesExplored();
+             }},
+            {"dancing_links_count", 14, [](int n) {
+                 NQueensSolver solver(n);
+                 solver.setVerbose(false);
+                 solver.countSolutionsDancingLinks();
+                 return solver.getNodesExplored();
+             }},
+            {"parallel_count", 16, [threads](int n) {
+                 NQueensSolver solver(n);
+                 solver.setVerbose(false);
+                 solver.countSolutionsParallel(threads);
+                 return solver.getNodesExplored();
+             }},
+        };
+    }
 
-            if (current.row == n) {
-                if (current.bound == 0) {
-                    solution = current.queens;
-                    solutionFound = true;
-                    break;
+    static vector<Result> run(const vector<Strategy>& list, int nFrom, int nTo, int warmup, int reps) {
+        vector<Result> results;
+        reps = max(1, reps);
+        for (const Strategy& strategy : list) {
+            for (int n = nFrom; n <= nTo && n <= strategy.maxN; ++n) {
+                for (int w = 0; w < warmup; ++w) strategy.run(n);
+
+                search::resetPeakRss();
+                vector<double> times;
+                long long nodes = 0;
+                long long allocsBefore = allocationCount.load(), bytesBefore = allocatedBytes.load();
+                for (int r = 0; r < reps; ++r) {
+                    auto start = steady_clock::now();
+                    nodes = strategy.run(n);
+                    times.push_back((double)duration_cast<nanoseconds>(steady_clock::now() - start).count());
                 }
-                continue;
+                long long allocs = allocationCount.load() - allocsBefore;
+                long long bytes = allocatedBytes.load() - bytesBefore;
+
+                Result res;
+                res.strategy = strategy.name;
+                res.n = n;
+                res.reps = reps;
+                sort(times.begin(), times.end());
+                res.medianNs = reps % 2 ? times[reps / 2] : (times[reps / 2 - 1] + times[reps / 2]) / 2;
+                res.p95Ns = times[(size_t)ceil(0.95 * reps) - 1];
+                res.minNs = times[0];
+                double total = 0;
+                for (double t : times) total += t;
+                res.meanNs = total / reps;
+                res.nodes = nodes;
+                res.nodesPerSec = res.medianNs > 0 ? nodes / (res.medianNs * 1e-9) : 0;
+                res.allocationsPerRun = (double)allocs / reps;
+                res.bytesPerRun = (double)bytes / reps;
+                res.peakRssKb = search::peakRssKb();
+                results.push_back(res);
             }
+        }
+        return results;
+    }
 
-            vector<int> colOrder(n);
-            for (int i = 0; i < n; ++i) colOrder[i] = i;
-
-            sort(colOrder.begin(), colOrder.end(), 
-                 [n=this->n](int a, int b) {
-                     return abs(a - (n-1)/2.0) < abs(b - (n-1)/2.0);
-                 });
-
-            for (int col : colOrder) {
-                if (isSafe(current.queens, current.row, col)) {
-                    QueensState next = current;
-                    next.queens[next.row] = col;
-                    next.row++;
-                    next.bound = calculateLowerBound(next);
-
-                    if (next.bound < bestBound) {
-                        bestBound = next.bound;
-                    }
+    static void writeCsv(ostream& out, const vector<Result>& results) {
+        out << "strategy,n,reps,median_ns,p95_ns,min_ns,mean_ns,nodes,nodes_per_sec,"
+               "allocations_per_run,bytes_per_run,peak_rss_kb\n";
+        out << fixed << setprecision(0);
+        for (const Result& r : results) {
+            out << r.strategy << "," << r.n << "," << r.reps << "," << r.medianNs << "," << r.p95Ns << ","
+                << r.minNs << "," << r.meanNs << "," << r.nodes << "," << r.nodesPerSec << ","
+                << r.allocationsPerRun << "," << r.bytesPerRun << "," << r.peakRssKb << "\n";
+        }
+    }
 
-                    if (next.bound == 0) {
-                        pq.push(next);
-                    }
-                }
-            }
+    static void writeJson(ostream& out, const vector<Result>& results) {
+        out << fixed << setprecision(0) << "[\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            out << "  {\"strategy\": \"" << r.strategy << "\", \"n\": " << r.n << ", \"reps\": " << r.reps
+                << ", \"median_ns\": " << r.medianNs << ", \"p95_ns\": " << r.p95Ns
+                << ", \"min_ns\": " << r.minNs << ", \"mean_ns\": " << r.meanNs
+                << ", \"nodes\": " << r.nodes << ", \"nodes_per_sec\": " << r.nodesPerSec
+                << ", \"allocations_per_run\": " << r.allocationsPerRun
+                << ", \"bytes_per_run\": " << r.bytesPerRun << ", \"peak_rss_kb\": " << r.peakRssKb << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
         }
+        out << "]\n";
+    }
+};
 
-        auto endTime = high_resolution_clock::now();
-        auto duration = duration_cast<milliseconds>(endTime - startTime).count();
+int runBenchmark() {
+    int nFrom, nTo, warmup, reps;
+    string outputPath;
+    cout << "Enter the smallest board size: ";
+    cin >> nFrom;
+    cout << "Enter the largest board size: ";
+    cin >> nTo;
+    cout << "Enter warmup runs per size: ";
+    cin >> warmup;
+    cout << "Enter timed repetitions per size: ";
+    cin >> reps;
+    cout << "Enter output file (.json for JSON, anything else for CSV, - for the console): ";
+    cin >> outputPath;
+
+    if (nFrom < 1 || nTo < nFrom) {
+        cout << "Invalid board size range.\n";
+        return 1;
+    }
 
-        cout << "CSP with Branch & Bound: " << (solutionFound ? "Solution found" : "No solution") 
-             << " in " << duration << " ms after exploring " << nodesExplored << " nodes.\n";
+    unsigned cores = thread::hardware_concurrency();
+    vector<SolverBenchmark::Result> results =
+        SolverBenchmark::run(SolverBenchmark::strategies(cores == 0 ? 1 : cores), nFrom, nTo, warmup, reps);
 
-        if (solutionFound) {
-            printBoard(solution);
-            return true;
-        }
-        return false;
+    if (outputPath == "-") {
+        SolverBenchmark::writeCsv(cout, results);
+        return 0;
     }
-};
+    ofstream out(outputPath);
+    if (!out) {
+        cout << "Could not open " << outputPath << " for writing.\n";
+        return 1;
+    }
+    bool json = outputPath.size() >= 5 && outputPath.compare(outputPath.size() - 5, 5, ".json") == 0;
+    if (json)
+        SolverBenchmark::writeJson(out, results);
+    else
+        SolverBenchmark::writeCsv(out, results);
+    cout << results.size() << " results written to " << outputPath << ".\n";
+    return 0;
+}
 
 int main() {
+    int mode;
+    cout << "1. Solve an N-Queens board\n";
+    cout << "2. Benchmark all strategies\n";
+    cout << "Enter your choice: ";
+    cin >> mode;
+    if (mode == 2) return runBenchmark();
+
     int n;
     cout << "Enter the board size (N) for N-Queens problem: ";
     cin >> n;
@@ -329,10 +2003,47 @@ int main() {
 
     cout << "\n=== Solving " << n << "-Queens Problem ===\n";
 
-    solver.solveBacktracking();
-    solver.solveConstraintBacktracking();
-    solver.solveBranchAndBound();
-    solver.solveCSPWithBranchAndBound();
+    // The exhaustive searches stop being practical around n = 30.
+    if (n <= 30) {
+        solver.solveBacktracking();
+        solver.solveConstraintBacktracking();
+        solver.solveBranchAndBound();
+        solver.solveCSPWithBranchAndBound();
+        solver.solveBitboard();
+        solver.solveGenericCSP();
+        solver.solveDancingLinks();
+    } else {
+        cout << "Skipping the exhaustive solvers for N > 30.\n";
+    }
+    if (n <= 10000000) solver.solveMinConflicts();
+
+    string outputPath;
+    cout << "\nFile to stream the constructive placement to (- to skip): ";
+    cin >> outputPath;
+    solver.solveConstructive(outputPath);
+
+    if (n > 64) return 0;
+
+    int countAll;
+    cout << "\nCount all solutions with the bitboard engine? (1 for yes, 0 for no): ";
+    cin >> countAll;
+    if (countAll == 1) {
+        solver.countSolutionsBitboard();
+        solver.countSolutionsConstraintBacktracking();
+        solver.countSolutionsDancingLinks();
+        unsigned cores = thread::hardware_concurrency();
+        solver.countSolutionsParallel(cores == 0 ? 1 : cores);
+    }
+
+    string solutionsPath;
+    cout << "\nFile to stream every solution to (- to skip): ";
+    cin >> solutionsPath;
+    if (solutionsPath != "-") {
+        int fundamentalOnly;
+        cout << "Only fundamental solutions (one per symmetry class)? (1 for yes, 0 for no): ";
+        cin >> fundamentalOnly;
+        solver.enumerateSolutions(solutionsPath, fundamentalOnly == 1);
+    }
 
     return 0;
 }
@@ -0,0 +1,388 @@
+// Weighted graph storage and loading shared by the graph programs: the CSR
+// SparseGraph, the buffered DIMACS / edge-list loader with its binary cache, and
+// sequential Dijkstra as the reference shortest-path routine.
+#ifndef LP_GRAPH_HPP
+#define LP_GRAPH_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "search.hpp"
+
+const long long LINF = LLONG_MAX / 4;
+
+struct WeightedEdge {
+    int u, v, w;
+};
+
+// Compressed sparse row graph: the arcs leaving u are
+// targets[offsets[u]] .. targets[offsets[u + 1] - 1] with matching weights.
+struct SparseGraph {
+    int n = 0;
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    std::vector<int> weights;
+
+    static SparseGraph fromEdges(int n, const std::vector<WeightedEdge>& edges, bool directed) {
+        SparseGraph g;
+        g.n = n;
+        g.offsets.assign(n + 1, 0);
+        for (const WeightedEdge& e : edges) {
+            g.offsets[e.u + 1]++;
+            if (!directed)
+                g.offsets[e.v + 1]++;
+        }
+        for (int i = 0; i < n; i++)
+            g.offsets[i + 1] += g.offsets[i];
+
+        g.targets.resize(g.offsets[n]);
+        g.weights.resize(g.offsets[n]);
+        std::vector<int> pos(g.offsets.begin(), g.offsets.end() - 1);
+        for (const WeightedEdge& e : edges) {
+            g.targets[pos[e.u]] = e.v;
+            g.weights[pos[e.u]++] = e.w;
+            if (!directed) {
+                g.targets[pos[e.v]] = e.u;
+                g.weights[pos[e.v]++] = e.w;
+            }
+        }
+        return g;
+    }
+
+    // Every arc as an edge; an undirected graph therefore lists each edge twice.
+    std::vector<WeightedEdge> toEdgeList() const {
+        std::vector<WeightedEdge> edges;
+        edges.reserve(targets.size());
+        for (int u = 0; u < n; u++)
+            for (int e = offsets[u]; e < offsets[u + 1]; e++)
+                edges.push_back({u, targets[e], weights[e]});
+        return edges;
+    }
+
+    int maxWeight() const {
+        int m = 0;
+        for (int w : weights)
+            m = std::max(m, w);
+        return m;
+    }
+};
+
+// fread-backed character reader with a large buffer, so parsing multi-gigabyte
+// edge files costs one system call per megabyte instead of one per token.
+class BufferedReader {
+private:
+    FILE* file;
+    std::vector<char> buffer;
+    size_t pos = 0, len = 0;
+
+    bool refill() {
+        pos = 0;
+        len = file ? fread(buffer.data(), 1, buffer.size(), file) : 0;
+        return len > 0;
+    }
+
+public:
+    BufferedReader(const std::string& path) : file(fopen(path.c_str(), "rb")), buffer(1 << 20) {}
+
+    ~BufferedReader() {
+        if (file)
+            fclose(file);
+    }
+
+    BufferedReader(const BufferedReader&) = delete;
+    BufferedReader& operator=(const BufferedReader&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    int peek() {
+        if (pos == len && !refill())
+            return EOF;
+        return (unsigned char)buffer[pos];
+    }
+
+    int get() {
+        int c = peek();
+        if (c != EOF)
+            pos++;
+        return c;
+    }
+
+    // Skips spaces and tabs but stops at end of line.
+    void skipBlanks() {
+        int c = peek();
+        while (c == ' ' || c == '\t' || c == '\r') {
+            pos++;
+            c = peek();
+        }
+    }
+
+    void skipLine() {
+        int c = get();
+        while (c != '\n' && c != EOF)
+            c = get();
+    }
+
+    bool readLong(long long& value) {
+        skipBlanks();
+        bool negative = false;
+        if (peek() == '-' || peek() == '+')
+            negative = get() == '-';
+        if (peek() < '0' || peek() > '9')
+            return false;
+        value = 0;
+        while (peek() >= '0' && peek() <= '9') {
+            if (value > (LLONG_MAX - 9) / 10)
+                return false;
+            value = value * 10 + (get() - '0');
+        }
+        if (negative)
+            value = -value;
+        return true;
+    }
+
+    std::string readWord() {
+        skipBlanks();
+        std::string word;
+        while (peek() != EOF && !std::isspace(peek()))
+            word += (char)get();
+        return word;
+    }
+};
+
+// Sequential binary-heap Dijkstra; the reference the parallel engines are checked against.
+inline std::vector<long long> dijkstraSparse(const SparseGraph& g, int src, std::vector<int>& from) {
+    std::vector<long long> dist(g.n, LINF);
+    from.assign(g.n, -1);
+    search::HeapOpenList<std::pair<long long, int>> pq;
+    pq.reserve(g.n);
+    dist[src] = 0;
+    pq.push({0, src});
+    while (!pq.empty()) {
+        std::pair<long long, int> top = pq.pop();
+        long long d = top.first;
+        int u = top.second;
+        if (d != dist[u])
+            continue;
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            int v = g.targets[e];
+            if (d + g.weights[e] < dist[v]) {
+                dist[v] = d + g.weights[e];
+                from[v] = u;
+                pq.push({dist[v], v});
+            }
+        }
+    }
+    return dist;
+}
+
+// Loads weighted graphs from DIMACS shortest-path files (.gr: "p sp n m" header and
+// 1-based "a u v w" arcs) or plain "u v w" edge lists (0-based, '#' or '%'
+// comments, vertex count = largest id + 1). Every vertex id and weight is range
+// checked. After a successful parse a binary CSR cache is written to <path>.csr and
+// reused while the source file's size and modification time are unchanged.
+class GraphLoader {
+private:
+    static constexpr uint64_t CACHE_MAGIC = 0x3130525343504c00ull; // "\0LPCSR01"
+
+    struct CacheHeader {
+        uint64_t magic;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        int32_t directed;
+        int32_t n;
+        int64_t arcs;
+    };
+
+    static bool sourceStamp(const std::string& path, uint64_t& size, int64_t& time) {
+        std::error_code ec;
+        size = std::filesystem::file_size(path, ec);
+        if (ec)
+            return false;
+        time = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+        return !ec;
+    }
+
+    static bool fail(std::string& error, const std::string& message, long long line) {
+        error = "line " + std::to_string(line) + ": " + message;
+        return false;
+    }
+
+    static bool checkWeight(long long w, std::string& error, long long line) {
+        if (w < INT_MIN || w > INT_MAX)
+            return fail(error, "weight " + std::to_string(w) + " out of range", line);
+        return true;
+    }
+
+    static bool parseDimacs(BufferedReader& in, int& n, std::vector<WeightedEdge>& edges, std::string& error) {
+        long long line = 0;
+        long long declaredN = -1;
+        while (in.peek() != EOF) {
+            line++;
+            in.skipBlanks();
+            int c = in.get();
+            if (c == '\n')
+                continue;
+            if (c == 'c') {
+                in.skipLine();
+                continue;
+            }
+            if (c == 'p') {
+                long long m;
+                if (declaredN >= 0)
+                    return fail(error, "second problem line", line);
+                if (in.readWord() != "sp" || !in.readLong(declaredN) || !in.readLong(m))
+                    return fail(error, "malformed problem line, expected 'p sp <n> <m>'", line);
+                if (declaredN < 0 || declaredN >= INT_MAX || m < 0 || m > INT_MAX)
+                    return fail(error, "problem size out of range", line);
+                // m is only a hint; a header that overstates it must not allocate.
+                edges.reserve(std::min<long long>(m, 1 << 24));
+            } else if (c == 'a') {
+                long long u, v, w;
+                if (declaredN < 0)
+                    return fail(error, "arc before the problem line", line);
+                if (!in.readLong(u) || !in.readLong(v) || !in.readLong(w))
+                    return fail(error, "malformed arc, expected 'a <u> <v> <w>'", line);
+                if (u < 1 || u > declaredN || v < 1 || v > declaredN)
+                    return fail(error, "vertex out of range 1.." + std::to_string(declaredN), line);
+                if (!checkWeight(w, error, line))
+                    return false;
+                edges.push_back({(int)u - 1, (int)v - 1, (int)w});
+            } else {
+                return fail(error, std::string("unknown line type '") + (char)c + "'", line);
+            }
+            in.skipLine();
+        }
+        if (declaredN < 0)
+            return fail(error, "missing problem line", line);
+        n = (int)declaredN;
+        return true;
+    }
+
+    static bool parseEdgeList(BufferedReader& in, int& n, std::vector<WeightedEdge>& edges, std::string& error) {
+        long long line = 0;
+        long long maxId = -1;
+        while (in.peek() != EOF) {
+            line++;
+            in.skipBlanks();
+            int c = in.peek();
+            if (c == '\n' || c == '#' || c == '%' || c == EOF) {
+                in.skipLine();
+                continue;
+            }
+            long long u, v, w;
+            if (!in.readLong(u) || !in.readLong(v) || !in.readLong(w))
+                return fail(error, "malformed edge, expected '<u> <v> <w>'", line);
+            if (u < 0 || v < 0 || u >= INT_MAX - 1 || v >= INT_MAX - 1)
+                return fail(error, "vertex id out of range", line);
+            if (!checkWeight(w, error, line))
+                return false;
+            maxId = std::max(maxId, std::max(u, v));
+            edges.push_back({(int)u, (int)v, (int)w});
+            in.skipLine();
+        }
+        n = (int)(maxId + 1);
+        return true;
+    }
+
+    static bool readCache(const std::string& path, bool directed, SparseGraph& g) {
+        uint64_t size;
+        int64_t time;
+        if (!sourceStamp(path, size, time))
+            return false;
+        std::string cachePath = path + ".csr";
+        std::ifstream in(cachePath, std::ios::binary);
+        CacheHeader h;
+        if (!in.read((char*)&h, sizeof(h)) || h.magic != CACHE_MAGIC || h.sourceSize != size ||
+            h.sourceTime != time || h.directed != (int32_t)directed || h.n < 0 || h.n >= INT_MAX || h.arcs < 0 ||
+            h.arcs > INT_MAX)
+            return false;
+        // The body must be exactly the three arrays the header promises, which
+        // also keeps a corrupt header from sizing huge allocations.
+        std::error_code ec;
+        uint64_t expected = sizeof(h) + ((uint64_t)h.n + 1 + 2 * (uint64_t)h.arcs) * sizeof(int);
+        if (std::filesystem::file_size(cachePath, ec) != expected || ec)
+            return false;
+        g.n = (int)h.n;
+        g.offsets.resize((size_t)h.n + 1);
+        g.targets.resize(h.arcs);
+        g.weights.resize(h.arcs);
+        in.read((char*)g.offsets.data(), g.offsets.size() * sizeof(int));
+        in.read((char*)g.targets.data(), g.targets.size() * sizeof(int));
+        in.read((char*)g.weights.data(), g.weights.size() * sizeof(int));
+        if (!in || g.offsets[0] != 0 || g.offsets[h.n] != h.arcs)
+            return false;
+        // Traversals index with these unchecked, so a stale or damaged cache is
+        // rejected (and rebuilt from the source) rather than trusted.
+        for (int u = 0; u < g.n; u++)
+            if (g.offsets[u] > g.offsets[u + 1])
+                return false;
+        for (int v : g.targets)
+            if (v < 0 || v >= g.n)
+                return false;
+        return true;
+    }
+
+    static void writeCache(const std::string& path, bool directed, const SparseGraph& g) {
+        CacheHeader h;
+        if (!sourceStamp(path, h.sourceSize, h.sourceTime))
+            return;
+        h.magic = CACHE_MAGIC;
+        h.directed = directed;
+        h.n = g.n;
+        h.arcs = g.targets.size();
+        std::string cachePath = path + ".csr";
+        std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+        out.write((const char*)&h, sizeof(h));
+        out.write((const char*)g.offsets.data(), g.offsets.size() * sizeof(int));
+        out.write((const char*)g.targets.data(), g.targets.size() * sizeof(int));
+        out.write((const char*)g.weights.data(), g.weights.size() * sizeof(int));
+        out.close();
+        // A partial cache would only be rejected on the next load; drop it now.
+        if (!out) {
+            std::error_code ec;
+            std::filesystem::remove(cachePath, ec);
+        }
+    }
+
+public:
+    static bool isDimacs(const std::string& path) {
+        return path.size() >= 3 && path.compare(path.size() - 3, 3, ".gr") == 0;
+    }
+
+    // DIMACS arcs are always directed; `directed` only applies to edge lists.
+    static bool load(const std::string& path, bool directed, SparseGraph& g, std::string& error, bool& fromCache) {
+        bool dimacs = isDimacs(path);
+        if (dimacs)
+            directed = true;
+        fromCache = readCache(path, directed, g);
+        if (fromCache)
+            return true;
+
+        BufferedReader in(path);
+        if (!in.isOpen()) {
+            error = "cannot open " + path;
+            return false;
+        }
+        int n = 0;
+        std::vector<WeightedEdge> edges;
+        bool ok = dimacs ? parseDimacs(in, n, edges, error) : parseEdgeList(in, n, edges, error);
+        if (!ok)
+            return false;
+        if (edges.size() * (directed ? 1 : 2) > (size_t)INT_MAX) {
+            error = "too many arcs for 32-bit offsets";
+            return false;
+        }
+        g = SparseGraph::fromEdges(n, edges, directed);
+        writeCache(path, directed, g);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,242 @@
+// The n x n sliding-tile puzzle as a search-library problem, shared by the
+// puzzle solver and the query server.
+//
+// Tiles are stored by label rather than face value: the blank is 0 and the other
+// tiles are numbered 1 .. n*n-1 in the row-major order of their goal cells, so
+// the goal cell of a tile is a table lookup and a label always fits in
+// ceil(log2(n*n)) bits. Callers with arbitrary face values relabel once on input.
+#ifndef LP_PUZZLE_HPP
+#define LP_PUZZLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+struct PuzzleBoard {
+    std::vector<uint8_t> tiles; // row-major labels
+    int blank;
+};
+
+class SlidingPuzzle {
+private:
+    int n;
+    int goalBlank;
+    std::vector<int> goalRow, goalCol; // by label
+    std::vector<uint8_t> goalTiles;
+
+public:
+    using State = PuzzleBoard;
+    using Key = std::string;
+
+    // Blank moves in action order: up, down, left, right.
+    static constexpr int DR[4] = {-1, 1, 0, 0};
+    static constexpr int DC[4] = {0, 0, -1, 1};
+    static constexpr char MOVES[5] = "UDLR";
+
+    // goalBlankCell defaults to the bottom-right corner.
+    explicit SlidingPuzzle(int size, int goalBlankCell = -1)
+        : n(size), goalBlank(goalBlankCell < 0 ? size * size - 1 : goalBlankCell), goalRow(size * size),
+          goalCol(size * size), goalTiles(size * size, 0) {
+        for (int label = 1; label < n * n; ++label) {
+            int cell = goalCell(label);
+            goalRow[label] = cell / n;
+            goalCol[label] = cell % n;
+            goalTiles[cell] = label;
+        }
+    }
+
+    int size() const { return n; }
+
+    // Goal cell of a tile label: labels count the goal's cells, skipping the blank.
+    int goalCell(int label) const { return label - 1 < goalBlank ? label - 1 : label; }
+
+    // The solver works on PuzzleBoard directly; PackedPuzzle converts.
+    const PuzzleBoard& fromBoard(const PuzzleBoard& b) const { return b; }
+    const PuzzleBoard& toBoard(const PuzzleBoard& b) const { return b; }
+
+    Key key(const PuzzleBoard& b) const {
+        return std::string(b.tiles.begin(), b.tiles.end());
+    }
+
+    bool isGoal(const PuzzleBoard& b) const {
+        return b.tiles == goalTiles;
+    }
+
+    // Manhattan distance heuristic
+    int heuristic(const PuzzleBoard& b) const {
+        int dist = 0;
+        for (int i = 0; i < n * n; ++i) {
+            int t = b.tiles[i];
+            if (t != 0) dist += std::abs(i / n - goalRow[t]) + std::abs(i % n - goalCol[t]);
+        }
+        return dist;
+    }
+
+    template <typename Emit>
+    void successors(const PuzzleBoard& b, Emit&& emit) const {
+        int x = b.blank / n, y = b.blank % n;
+        for (int i = 0; i < 4; ++i) {
+            int newX = x + DR[i];
+            int newY = y + DC[i];
+            if (newX >= 0 && newX < n && newY >= 0 && newY < n) {
+                PuzzleBoard next = b;
+                next.blank = newX * n + newY;
+                std::swap(next.tiles[b.blank], next.tiles[next.blank]);
+                emit(next, 1, i);
+            }
+        }
+    }
+
+    // Every move is a transposition involving the blank, so a board is reachable
+    // exactly when the parity of its cell permutation relative to the goal
+    // matches the parity of the blank's Manhattan distance from its goal cell.
+    bool solvable(const PuzzleBoard& b) const {
+        std::vector<int> target(n * n);
+        for (int i = 0; i < n * n; ++i) target[i] = b.tiles[i] == 0 ? goalBlank : goalCell(b.tiles[i]);
+        std::vector<char> seen(n * n, 0);
+        int transpositions = 0;
+        for (int i = 0; i < n * n; ++i) {
+            if (seen[i]) continue;
+            int length = 0;
+            for (int j = i; !seen[j]; j = target[j]) {
+                seen[j] = 1;
+                length++;
+            }
+            transpositions += length - 1;
+        }
+        int blankDistance = std::abs(b.blank / n - goalBlank / n) + std::abs(b.blank % n - goalBlank % n);
+        return transpositions % 2 == blankDistance % 2;
+    }
+
+    // Heap bytes behind a board or a key, with glibc's per-allocation overhead
+    // (8-byte header, 16-byte granularity, 32-byte minimum); libstdc++ keeps
+    // strings of up to 15 characters inline. Lets memory-capped searches count
+    // what the states really cost.
+    static size_t allocationBytes(size_t n) { return n == 0 ? 0 : std::max<size_t>(32, (n + 8 + 15) / 16 * 16); }
+    size_t heapBytes(const PuzzleBoard& b) const { return allocationBytes(b.tiles.capacity()); }
+    size_t heapBytes(const Key& k) const { return k.capacity() > 15 ? allocationBytes(k.capacity() + 1) : 0; }
+
+    static std::string pathString(const std::vector<int>& actions) {
+        std::string path;
+        for (int a : actions) path += MOVES[a];
+        return path;
+    }
+};
+
+// SlidingPuzzle specialised on the board size, for the solver's inner loop. With
+// N a constant the neighbour and distance tables are constexpr, the four-move
+// loop unrolls, and a board is a single integer of 4-bit cells (uint64_t up to
+// 4x4) or 5-bit cells (unsigned __int128 for 5x5), so copying, hashing and
+// comparing states is a few word operations. The state also carries the blank's
+// cell and its Manhattan distance, which a move updates from the one tile it
+// slides instead of rescanning the board. Actions and labels match
+// SlidingPuzzle's.
+template <int N>
+class PackedPuzzle {
+public:
+    static constexpr int CELLS = N * N;
+    static constexpr int BITS = CELLS <= 16 ? 4 : 5;
+    static_assert(N >= 2 && CELLS * BITS <= 128, "PackedPuzzle covers 2x2 .. 5x5");
+
+    using Word = std::conditional_t<CELLS * BITS <= 64, uint64_t, unsigned __int128>;
+
+    struct State {
+        Word tiles;
+        int blank;
+        int h;
+    };
+    using Key = Word;
+
+    struct KeyHash {
+        size_t operator()(Word w) const {
+            if constexpr (sizeof(Word) > 8)
+                return size_t(uint64_t(w) ^ uint64_t(w >> 64) * 0x9E3779B97F4A7C15ULL);
+            else
+                return size_t(w);
+        }
+    };
+
+private:
+    static constexpr Word MASK = (Word(1) << BITS) - 1;
+
+    // NEIGHBOR[cell][action] is where the blank lands, or -1 off the board.
+    static constexpr std::array<std::array<int, 4>, CELLS> makeNeighbors() {
+        std::array<std::array<int, 4>, CELLS> t{};
+        for (int c = 0; c < CELLS; ++c)
+            for (int a = 0; a < 4; ++a) {
+                int r = c / N + SlidingPuzzle::DR[a], col = c % N + SlidingPuzzle::DC[a];
+                t[c][a] = r >= 0 && r < N && col >= 0 && col < N ? r * N + col : -1;
+            }
+        return t;
+    }
+
+    static constexpr std::array<std::array<uint8_t, CELLS>, CELLS> makeCellDistances() {
+        std::array<std::array<uint8_t, CELLS>, CELLS> t{};
+        for (int a = 0; a < CELLS; ++a)
+            for (int b = 0; b < CELLS; ++b) {
+                int dr = a / N - b / N, dc = a % N - b % N;
+                t[a][b] = uint8_t((dr < 0 ? -dr : dr) + (dc < 0 ? -dc : dc));
+            }
+        return t;
+    }
+
+    static constexpr auto NEIGHBOR = makeNeighbors();
+    static constexpr auto CELL_DISTANCE = makeCellDistances();
+
+    int goalBlank;
+    Word goalTiles = 0;
+    std::array<std::array<uint8_t, CELLS>, CELLS> distance{}; // [label][cell] to the label's goal cell
+
+    static int tileAt(Word tiles, int cell) { return int((tiles >> (cell * BITS)) & MASK); }
+
+public:
+    explicit PackedPuzzle(int goalBlankCell = -1) : goalBlank(goalBlankCell < 0 ? CELLS - 1 : goalBlankCell) {
+        for (int label = 1; label < CELLS; ++label) {
+            int cell = label - 1 < goalBlank ? label - 1 : label;
+            goalTiles |= Word(label) << (cell * BITS);
+            distance[label] = CELL_DISTANCE[cell];
+        }
+    }
+
+    static constexpr int size() { return N; }
+
+    State fromBoard(const PuzzleBoard& b) const {
+        State s{0, b.blank, 0};
+        for (int i = 0; i < CELLS; ++i) {
+            s.tiles |= Word(b.tiles[i]) << (i * BITS);
+            if (b.tiles[i] != 0) s.h += distance[b.tiles[i]][i];
+        }
+        return s;
+    }
+
+    PuzzleBoard toBoard(const State& s) const {
+        PuzzleBoard b;
+        b.tiles.resize(CELLS);
+        for (int i = 0; i < CELLS; ++i) b.tiles[i] = uint8_t(tileAt(s.tiles, i));
+        b.blank = s.blank;
+        return b;
+    }
+
+    Key key(const State& s) const { return s.tiles; }
+    bool isGoal(const State& s) const { return s.tiles == goalTiles; }
+    int heuristic(const State& s) const { return s.h; }
+
+    template <typename Emit>
+    void successors(const State& s, Emit&& emit) const {
+        for (int a = 0; a < 4; ++a) {
+            int to = NEIGHBOR[s.blank][a];
+            if (to < 0) continue;
+            int tile = tileAt(s.tiles, to);
+            // The blank's cell holds 0, so two xors move the tile across.
+            State next{s.tiles ^ (Word(tile) << (to * BITS)) ^ (Word(tile) << (s.blank * BITS)), to,
+                       s.h - distance[tile][to] + distance[tile][s.blank]};
+            emit(next, 1, a);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,757 @@
+// Long-running query server: graphs are loaded once at start-up, then BFS,
+// shortest-path and puzzle queries arrive over a Unix domain socket and are
+// answered from a thread pool, with an LRU cache of recent answers.
+//
+//   query_server --socket PATH [--threads K] [--cache ENTRIES] [--puzzle-limit NODES]
+//                [--graph NAME=FILE[:undirected]]...
+//   query_server --client PATH [QUERY]...      (queries from stdin when none given)
+//
+// The protocol is one query per line, one answer line per query:
+//
+//   GRAPHS                      -> OK <name>:<vertices>:<arcs> ...
+//   BFS <graph> <src> <dst>     -> OK <hops> <src> ... <dst> | OK unreachable
+//   PATH <graph> <src> <dst>    -> OK <distance> <src> ... <dst> | OK unreachable
+//                                  (ERR on graphs with negative weights)
+//   PUZZLE <n> <n*n tiles>      -> OK <moves> <UDLR...>        (goal 1 .. n*n-1, blank last)
+//   STATS                       -> OK queries <q> hits <h> p50_us <..> p90_us <..> p99_us <..> max_us <..>
+//
+// Errors come back as "ERR <reason>".
+//
+// --threads K sets the worker count. Connections are watched by one poll loop
+// and each query goes to the pool on its own, so idle clients hold no worker.
+// Queries on one connection are answered one at a time, in order; queries on
+// different connections run in parallel.
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <map>
+#include <set>
+#include <list>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cctype>
+#include <csignal>
+#include <cstring>
+#include "search.hpp"
+#include "graph.hpp"
+#include "puzzle.hpp"
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Fixed set of workers draining a FIFO of tasks.
+class ThreadPool {
+private:
+    vector<thread> workers;
+    deque<function<void()>> tasks;
+    mutex lock;
+    condition_variable ready;
+    bool stopping = false;
+
+public:
+    explicit ThreadPool(int threads) {
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([this] {
+                while (true) {
+                    function<void()> task;
+                    {
+                        unique_lock<mutex> guard(lock);
+                        ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+                        if (tasks.empty())
+                            return;
+                        task = move(tasks.front());
+                        tasks.pop_front();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (thread& w : workers)
+            w.join();
+    }
+
+    void submit(function<void()> task) {
+        {
+            lock_guard<mutex> guard(lock);
+            tasks.push_back(move(task));
+        }
+        ready.notify_one();
+    }
+};
+
+// Least-recently-used map from query text to answer text.
+class LruCache {
+private:
+    size_t capacity;
+    list<pair<string, string>> entries; // most recent first
+    unordered_map<string, list<pair<string, string>>::iterator> byKey;
+    mutex lock;
+
+public:
+    explicit LruCache(size_t entriesMax) : capacity(entriesMax) {}
+
+    bool get(const string& key, string& value) {
+        lock_guard<mutex> guard(lock);
+        auto it = byKey.find(key);
+        if (it == byKey.end())
+            return false;
+        entries.splice(entries.begin(), entries, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    void put(const string& key, const string& value) {
+        if (capacity == 0)
+            return;
+        lock_guard<mutex> guard(lock);
+        auto it = byKey.find(key);
+        if (it != byKey.end()) {
+            it->second->second = value;
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+        entries.emplace_front(key, value);
+        byKey[key] = entries.begin();
+        if (entries.size() > capacity) {
+            byKey.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+};
+
+// Query latencies in microseconds over a sliding window of the most recent
+// queries, so percentiles follow the current load rather than all history.
+class LatencyStats {
+private:
+    static const size_t WINDOW = 1 << 16;
+    vector<double> samples;
+    size_t next = 0;
+    long long total = 0;
+    long long hits = 0;
+    mutex lock;
+
+public:
+    void record(double micros, bool cacheHit) {
+        lock_guard<mutex> guard(lock);
+        if (samples.size() < WINDOW)
+            samples.push_back(micros);
+        else
+            samples[next] = micros;
+        next = (next + 1) % WINDOW;
+        total++;
+        hits += cacheHit;
+    }
+
+    string report() {
+        vector<double> sorted;
+        long long queries, cacheHits;
+        {
+            lock_guard<mutex> guard(lock);
+            sorted = samples;
+            queries = total;
+            cacheHits = hits;
+        }
+        sort(sorted.begin(), sorted.end());
+        auto pct = [&](double p) {
+            return sorted.empty() ? 0.0 : sorted[min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+        };
+        ostringstream out;
+        out.setf(ios::fixed);
+        out.precision(1);
+        out << "OK queries " << queries << " hits " << cacheHits << " p50_us " << pct(0.50) << " p90_us "
+            << pct(0.90) << " p99_us " << pct(0.99) << " max_us " << (sorted.empty() ? 0.0 : sorted.back());
+        return out.str();
+    }
+};
+
+class QueryServer {
+private:
+    map<string, SparseGraph> graphs;
+    set<string> negativeGraphs; // Dijkstra is wrong on these, so PATH refuses them
+    map<int, unique_ptr<SlidingPuzzle>> puzzles; // Manhattan tables per board size
+    mutex puzzleLock;
+    long long puzzleLimit;
+    LruCache cache;
+    LatencyStats stats;
+
+    const SparseGraph* findGraph(const string& name) const {
+        auto it = graphs.find(name);
+        return it == graphs.end() ? nullptr : &it->second;
+    }
+
+    const SlidingPuzzle& puzzle(int n) {
+        lock_guard<mutex> guard(puzzleLock);
+        unique_ptr<SlidingPuzzle>& p = puzzles[n];
+        if (!p)
+            p.reset(new SlidingPuzzle(n));
+        return *p;
+    }
+
+    static string pathAnswer(long long length, const vector<int>& from, int src, int dst) {
+        vector<int> path;
+        for (int v = dst; v != -1; v = v == src ? -1 : from[v])
+            path.push_back(v);
+        ostringstream out;
+        out << "OK " << length;
+        for (auto it = path.rbegin(); it != path.rend(); ++it)
+            out << " " << *it;
+        return out.str();
+    }
+
+    // Hop-count BFS ignoring weights, stopping once dst is reached.
+    static string bfs(const SparseGraph& g, int src, int dst) {
+        vector<int> from(g.n, -1);
+        vector<int> level(g.n, -1);
+        vector<int> queue{src};
+        level[src] = 0;
+        for (size_t head = 0; head < queue.size() && level[dst] == -1; head++) {
+            int u = queue[head];
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[e];
+                if (level[v] == -1) {
+                    level[v] = level[u] + 1;
+                    from[v] = u;
+                    queue.push_back(v);
+                }
+            }
+        }
+        if (level[dst] == -1)
+            return "OK unreachable";
+        return pathAnswer(level[dst], from, src, dst);
+    }
+
+    // Dijkstra from src, stopping once dst is settled.
+    static string shortestPath(const SparseGraph& g, int src, int dst) {
+        vector<long long> dist(g.n, LINF);
+        vector<int> from(g.n, -1);
+        search::HeapOpenList<pair<long long, int>> pq;
+        dist[src] = 0;
+        pq.push({0, src});
+        while (!pq.empty()) {
+            pair<long long, int> top = pq.pop();
+            int u = top.second;
+            if (top.first != dist[u])
+                continue;
+            if (u == dst)
+                break;
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[e];
+                if (top.first + g.weights[e] < dist[v]) {
+                    dist[v] = top.first + g.weights[e];
+                    from[v] = u;
+                    pq.push({dist[v], v});
+                }
+            }
+        }
+        if (dist[dst] == LINF)
+            return "OK unreachable";
+        return pathAnswer(dist[dst], from, src, dst);
+    }
+
+    string solvePuzzle(istringstream& in) {
+        int n;
+        if (!(in >> n) || n < 2 || n > 15)
+            return "ERR puzzle size must be 2..15";
+        PuzzleBoard board;
+        board.tiles.resize(n * n);
+        board.blank = -1;
+        vector<char> seen(n * n, 0);
+        for (int i = 0; i < n * n; i++) {
+            int t;
+            if (!(in >> t) || t < 0 || t >= n * n || seen[t])
+                return "ERR expected a permutation of 0.." + to_string(n * n - 1);
+            seen[t] = 1;
+            board.tiles[i] = t;
+            if (t == 0)
+                board.blank = i;
+        }
+        const SlidingPuzzle& problem = puzzle(n);
+        if (!problem.solvable(board))
+            return "ERR unsolvable";
+
+        search::BestFirstSearch<SlidingPuzzle> astar(problem);
+        search::BestFirstOptions options;
+        options.maxExpansions = puzzleLimit;
+        search::SearchResult<PuzzleBoard> result = astar.run(board, options);
+        if (!result.found)
+            return "ERR expansion limit reached";
+        return "OK " + to_string(result.cost) + " " + SlidingPuzzle::pathString(result.actions);
+    }
+
+    string graphList() const {
+        string out = "OK";
+        for (const auto& entry : graphs)
+            out += " " + entry.first + ":" + to_string(entry.second.n) + ":" + to_string(entry.second.targets.size());
+        return out;
+    }
+
+    string evaluate(const string& line) {
+        istringstream in(line);
+        string command;
+        in >> command;
+        for (char& c : command)
+            c = toupper((unsigned char)c);
+
+        if (command == "GRAPHS")
+            return graphList();
+        if (command == "PUZZLE")
+            return solvePuzzle(in);
+        if (command == "BFS" || command == "PATH") {
+            string name;
+            long long src, dst;
+            if (!(in >> name >> src >> dst))
+                return "ERR usage: " + command + " <graph> <src> <dst>";
+            const SparseGraph* g = findGraph(name);
+            if (g == nullptr)
+                return "ERR no graph named " + name;
+            if (src < 0 || src >= g->n || dst < 0 || dst >= g->n)
+                return "ERR vertex out of range 0.." + to_string(g->n - 1);
+            if (command == "BFS")
+                return bfs(*g, src, dst);
+            if (negativeGraphs.count(name))
+                return "ERR graph " + name + " has negative weights; PATH needs non-negative weights";
+            return shortestPath(*g, src, dst);
+        }
+        return "ERR unknown command " + command;
+    }
+
+public:
+    QueryServer(size_t cacheEntries, long long puzzleNodeLimit)
+        : puzzleLimit(puzzleNodeLimit), cache(cacheEntries) {}
+
+    bool addGraph(const string& name, const string& path, bool directed, string& error) {
+        SparseGraph g;
+        bool fromCache;
+        if (!GraphLoader::load(path, directed, g, error, fromCache))
+            return false;
+        bool negative = any_of(g.weights.begin(), g.weights.end(), [](int w) { return w < 0; });
+        cerr << "Loaded " << name << ": " << g.n << " vertices, " << g.targets.size() << " arcs"
+             << (fromCache ? " (binary cache)" : "") << (negative ? " (negative weights: PATH disabled)" : "")
+             << "\n";
+        if (negative)
+            negativeGraphs.insert(name);
+        else
+            negativeGraphs.erase(name);
+        graphs[name] = move(g);
+        return true;
+    }
+
+    // Answers one query line. STATS is never cached, and neither is any ERR
+    // answer, so a transient failure such as the expansion limit is retried.
+    // Everything else is keyed by the line with the command upper-cased and runs
+    // of blanks collapsed, so neither case nor spacing defeats the cache.
+    string answer(const string& line) {
+        search::Stopwatch timer;
+        string key;
+        istringstream words(line);
+        for (string w; words >> w;) {
+            if (key.empty())
+                for (char& c : w)
+                    c = toupper((unsigned char)c);
+            key += (key.empty() ? "" : " ") + w;
+        }
+        if (key.empty())
+            return "ERR empty query";
+        if (key == "STATS" || key.compare(0, 6, "STATS ") == 0)
+            return stats.report();
+
+        string result;
+        bool hit = cache.get(key, result);
+        if (!hit) {
+            result = evaluate(key);
+            if (result.compare(0, 2, "OK") == 0)
+                cache.put(key, result);
+        }
+        stats.record(timer.elapsedMs() * 1000, hit);
+        return result;
+    }
+};
+
+#ifndef _WIN32
+static atomic<bool> stopRequested(false);
+static int listenFd = -1;
+static int wakeFd = -1; // write end of the poll loop's wake-up pipe
+
+static void requestStop(int) {
+    stopRequested = true;
+    if (wakeFd >= 0) {
+        char byte = 1;
+        ssize_t ignored = write(wakeFd, &byte, 1);
+        (void)ignored;
+    }
+}
+
+static bool writeAll(int fd, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t k = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (k <= 0)
+            return false;
+        sent += k;
+    }
+    return true;
+}
+
+// Reads newline-terminated lines from a socket through a small buffer.
+class LineReader {
+private:
+    int fd;
+    string pending;
+
+public:
+    explicit LineReader(int socket) : fd(socket) {}
+
+    bool next(string& line) {
+        while (true) {
+            size_t nl = pending.find('\n');
+            if (nl != string::npos) {
+                line = pending.substr(0, nl);
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                pending.erase(0, nl + 1);
+                return true;
+            }
+            char buffer[4096];
+            ssize_t k = recv(fd, buffer, sizeof(buffer), 0);
+            if (k <= 0) {
+                if (pending.empty())
+                    return false;
+                line.swap(pending);
+                pending.clear();
+                return true;
+            }
+            pending.append(buffer, k);
+        }
+    }
+};
+
+static int openSocket(const string& path, bool listening) {
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        cerr << "Socket path too long: " << path << "\n";
+        return -1;
+    }
+    strcpy(addr.sun_path, path.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    if (listening) {
+        unlink(path.c_str());
+        if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 128) < 0) {
+            perror("bind/listen");
+            close(fd);
+            return -1;
+        }
+    } else if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        perror("connect");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// One client connection. The poll loop reads its bytes and queues complete
+// lines; at most one of its queries is in the pool at a time, so answers go back
+// in the order the queries arrived.
+struct Connection {
+    int fd;
+    string pending;        // bytes after the last newline
+    deque<string> queries; // complete lines not yet answered
+    bool busy = false;     // a worker is answering one of its queries
+    bool eof = false;      // the client closed its side
+    bool broken = false;   // a reply could not be written
+
+    explicit Connection(int socket) : fd(socket) {}
+};
+
+// Watches the listening socket and every connection with poll() on the calling
+// thread and hands each query to the pool on its own, so an idle client holds
+// no worker. Only the poll thread closes client sockets; workers that finish
+// with a closed connection wake it through a pipe.
+class PollServer {
+private:
+    QueryServer& server;
+    unique_ptr<ThreadPool> pool;
+    mutex lock;
+    map<int, shared_ptr<Connection>> connections;
+    int wakeRead, wakeWrite;
+
+    void wake() {
+        char byte = 1;
+        ssize_t ignored = write(wakeWrite, &byte, 1); // a full pipe already means "wake up"
+        (void)ignored;
+    }
+
+    // Called with lock held.
+    void dispatch(const shared_ptr<Connection>& c) {
+        if (c->busy || c->queries.empty())
+            return;
+        c->busy = true;
+        string line = move(c->queries.front());
+        c->queries.pop_front();
+        pool->submit([this, c, line] { serve(c, line); });
+    }
+
+    void serve(const shared_ptr<Connection>& c, const string& line) {
+        bool sent = writeAll(c->fd, server.answer(line) + "\n");
+        lock_guard<mutex> guard(lock);
+        c->busy = false;
+        if (!sent) {
+            c->broken = true;
+            c->queries.clear();
+        }
+        dispatch(c);
+        if (!c->busy && (c->eof || c->broken))
+            wake();
+    }
+
+    // Called with lock held; false once the client has closed its side.
+    bool readFrom(const shared_ptr<Connection>& c) {
+        char buffer[4096];
+        ssize_t k = recv(c->fd, buffer, sizeof(buffer), 0);
+        if (k <= 0) {
+            if (!c->pending.empty())
+                c->queries.push_back(move(c->pending));
+            c->pending.clear();
+            return false;
+        }
+        c->pending.append(buffer, k);
+        size_t start = 0;
+        for (size_t nl; (nl = c->pending.find('\n', start)) != string::npos; start = nl + 1) {
+            string line = c->pending.substr(start, nl - start);
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            c->queries.push_back(move(line));
+        }
+        c->pending.erase(0, start);
+        return true;
+    }
+
+public:
+    PollServer(QueryServer& queryServer, int threads, int wakeReadFd, int wakeWriteFd)
+        : server(queryServer), pool(new ThreadPool(threads)), wakeRead(wakeReadFd), wakeWrite(wakeWriteFd) {}
+
+    ~PollServer() {
+        // Drop queued queries and stop reading, let the ones in flight send their
+        // answers, then close every client.
+        {
+            lock_guard<mutex> guard(lock);
+            for (auto& entry : connections) {
+                entry.second->queries.clear();
+                shutdown(entry.first, SHUT_RD);
+            }
+        }
+        pool.reset();
+        for (auto& entry : connections)
+            close(entry.first);
+    }
+
+    void run(int listenSocket) {
+        vector<pollfd> watched;
+        vector<shared_ptr<Connection>> watchedConnections;
+        while (!stopRequested) {
+            watched.assign({{wakeRead, POLLIN, 0}, {listenSocket, POLLIN, 0}});
+            watchedConnections.clear();
+            {
+                lock_guard<mutex> guard(lock);
+                for (auto& entry : connections)
+                    if (!entry.second->eof && !entry.second->broken) {
+                        watched.push_back({entry.first, POLLIN, 0});
+                        watchedConnections.push_back(entry.second);
+                    }
+            }
+            if (poll(watched.data(), watched.size(), -1) < 0)
+                continue; // EINTR from the stop signal; the loop condition decides
+            if (stopRequested)
+                break;
+
+            if (watched[0].revents) {
+                char drain[64];
+                while (read(wakeRead, drain, sizeof(drain)) > 0) {
+                }
+            }
+            if (watched[1].revents & POLLIN) {
+                int fd = accept(listenSocket, nullptr, nullptr);
+                if (fd >= 0) {
+                    lock_guard<mutex> guard(lock);
+                    connections[fd] = make_shared<Connection>(fd);
+                }
+            }
+
+            lock_guard<mutex> guard(lock);
+            for (size_t i = 0; i < watchedConnections.size(); i++) {
+                if (!watched[i + 2].revents)
+                    continue;
+                const shared_ptr<Connection>& c = watchedConnections[i];
+                if (!readFrom(c))
+                    c->eof = true;
+                dispatch(c);
+            }
+            for (auto it = connections.begin(); it != connections.end();) {
+                Connection& c = *it->second;
+                if ((c.eof || c.broken) && !c.busy && c.queries.empty()) {
+                    close(c.fd);
+                    it = connections.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+};
+
+static int runServer(const string& socketPath, QueryServer& server, int threads) {
+    int wake[2];
+    if (pipe(wake) < 0) {
+        perror("pipe");
+        return 1;
+    }
+    fcntl(wake[0], F_SETFL, O_NONBLOCK);
+    fcntl(wake[1], F_SETFL, O_NONBLOCK);
+    listenFd = openSocket(socketPath, true);
+    if (listenFd < 0)
+        return 1;
+    wakeFd = wake[1];
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = requestStop;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    {
+        PollServer poller(server, threads, wake[0], wake[1]);
+        cerr << "Listening on " << socketPath << " with " << threads << " worker thread(s).\n";
+        poller.run(listenFd);
+    }
+    wakeFd = -1;
+    close(wake[0]);
+    close(wake[1]);
+    close(listenFd);
+    unlink(socketPath.c_str());
+    cerr << "Server stopped.\n";
+    return 0;
+}
+
+static int runClient(const string& socketPath, const vector<string>& queries) {
+    int fd = openSocket(socketPath, false);
+    if (fd < 0)
+        return 1;
+    signal(SIGPIPE, SIG_IGN);
+    LineReader reader(fd);
+    auto ask = [&](const string& query) {
+        string reply;
+        if (!writeAll(fd, query + "\n") || !reader.next(reply))
+            return false;
+        cout << reply << "\n";
+        return true;
+    };
+    bool ok = true;
+    if (queries.empty()) {
+        for (string line; ok && getline(cin, line);)
+            if (!line.empty())
+                ok = ask(line);
+    } else {
+        for (const string& q : queries)
+            if (!(ok = ask(q)))
+                break;
+    }
+    close(fd);
+    return ok ? 0 : 1;
+}
+#endif
+
+int main(int argc, char** argv) {
+#ifdef _WIN32
+    cerr << "The query server needs Unix domain sockets and is not built for Windows.\n";
+    return 1;
+#else
+    string socketPath, clientPath;
+    int threads = search::defaultThreadCount();
+    size_t cacheEntries = 4096;
+    long long puzzleLimit = 2000000;
+    vector<string> graphSpecs, queries;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--socket" && hasValue)
+            socketPath = argv[++i];
+        else if (arg == "--client" && hasValue)
+            clientPath = argv[++i];
+        else if (arg == "--threads" && hasValue)
+            threads = max(1, atoi(argv[++i]));
+        else if (arg == "--cache" && hasValue)
+            cacheEntries = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--puzzle-limit" && hasValue)
+            puzzleLimit = max(1LL, atoll(argv[++i]));
+        else if (arg == "--graph" && hasValue)
+            graphSpecs.push_back(argv[++i]);
+        else if (!clientPath.empty())
+            queries.push_back(arg);
+        else {
+            cerr << "Unknown argument " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (!clientPath.empty())
+        return runClient(clientPath, queries);
+    if (socketPath.empty()) {
+        cerr << "Usage: " << argv[0] << " --socket PATH [--threads K] [--cache ENTRIES] [--puzzle-limit NODES]"
+             << " [--graph NAME=FILE[:undirected]]...\n"
+             << "       " << argv[0] << " --client PATH [QUERY]...\n";
+        return 1;
+    }
+
+    QueryServer server(cacheEntries, puzzleLimit);
+    for (const string& spec : graphSpecs) {
+        size_t eq = spec.find('=');
+        if (eq == string::npos || eq == 0) {
+            cerr << "Graph spec must be NAME=FILE[:undirected]: " << spec << "\n";
+            return 1;
+        }
+        string name = spec.substr(0, eq), path = spec.substr(eq + 1);
+        bool directed = true;
+        const string suffix = ":undirected";
+        if (path.size() > suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            directed = false;
+            path.resize(path.size() - suffix.size());
+        }
+        string error;
+        if (!server.addGraph(name, path, directed, error)) {
+            cerr << "Could not load graph " << name << ": " << error << "\n";
+            return 1;
+        }
+    }
+    return runServer(socketPath, server, threads);
+#endif
+}
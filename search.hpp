@@ -0,0 +1,1146 @@
+// Shared search library for the assignment programs. Everything a solver needs
+// besides its own problem definition lives here: timing, node allocators, open
+// lists, closed sets and the generic traversals / best-first engine, so an
+// improvement to any of them reaches every program that includes this header.
+//
+// A search problem is any type P that provides
+//
+//     using State = ...;                       // copyable
+//     using Key = ...;                         // hashable, equality-comparable
+//     Key key(const State& s) const;           // duplicate-detection key
+//     bool isGoal(const State& s) const;
+//     int heuristic(const State& s) const;     // informed searches only
+//     template <typename Emit>
+//     void successors(const State& s, Emit&& emit) const;
+//
+// where successors calls emit(State next, int cost, int action) once per child
+// in the order the children should be tried. The action is an opaque label the
+// caller gets back on the solution path (a move letter, an edge index, ...).
+// A problem whose Key has no std::hash names its own with `using KeyHash = ...`.
+#ifndef LP_SEARCH_HPP
+#define LP_SEARCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace search {
+
+// Wall-clock timer on steady_clock.
+class Stopwatch {
+private:
+    std::chrono::steady_clock::time_point start;
+
+public:
+    Stopwatch() : start(std::chrono::steady_clock::now()) {}
+
+    void reset() {
+        start = std::chrono::steady_clock::now();
+    }
+
+    double elapsedMs() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Runs fn(0) .. fn(threads - 1), one call per thread, on the calling thread plus
+// threads - 1 workers.
+template <typename Fn>
+void parallelFor(int threads, Fn fn) {
+    if (threads <= 1) {
+        fn(0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(fn, t);
+    fn(0);
+    for (std::thread& w : workers)
+        w.join();
+}
+
+inline int defaultThreadCount() {
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : (int)hw;
+}
+
+// Process memory high-water mark (defined in search.cpp). resetPeakRss() restarts
+// the mark where the OS allows it (Linux clear_refs); elsewhere peakRssKb() is
+// the process peak so far.
+void resetPeakRss();
+long long peakRssKb();
+
+// Append-only node storage in fixed-size chunks: nodes never move, are addressed
+// by index, and are all released together when the arena goes away.
+template <typename T>
+class Arena {
+private:
+    static const size_t CHUNK = 1 << 16;
+    std::vector<std::unique_ptr<T[]>> chunks;
+    size_t count = 0;
+
+public:
+    size_t allocate() {
+        if (count == chunks.size() * CHUNK) chunks.emplace_back(new T[CHUNK]);
+        return count++;
+    }
+
+    T& operator[](size_t i) { return chunks[i / CHUNK][i % CHUNK]; }
+    const T& operator[](size_t i) const { return chunks[i / CHUNK][i % CHUNK]; }
+    size_t size() const { return count; }
+    size_t bytes() const { return chunks.size() * CHUNK * sizeof(T); }
+
+    // What bytes() would be after extra more allocations.
+    size_t bytesAfter(size_t extra) const { return (count + extra + CHUNK - 1) / CHUNK * CHUNK * sizeof(T); }
+
+    void clear() {
+        chunks.clear();
+        count = 0;
+    }
+};
+
+// FIFO over a single vector: pushes append, pops advance a head index, and the
+// storage is recycled once the queue drains, so a BFS level costs no per-node
+// allocation after the first few.
+template <typename T>
+class FifoQueue {
+private:
+    std::vector<T> items;
+    size_t head = 0;
+
+public:
+    void push(const T& item) {
+        items.push_back(item);
+    }
+
+    T pop() {
+        T item = items[head++];
+        if (head == items.size()) {
+            items.clear();
+            head = 0;
+        }
+        return item;
+    }
+
+    bool empty() const { return head == items.size(); }
+    size_t size() const { return items.size() - head; }
+};
+
+// Min-heap with four children per node: half the depth of a binary heap and the
+// children of a node share a cache line, which pays off on the pop-heavy
+// workloads of Dijkstra and A*. Less(a, b) means a comes out first.
+template <typename T, typename Less = std::less<T>>
+class HeapOpenList {
+private:
+    std::vector<T> heap;
+    Less less;
+
+    void siftUp(size_t i) {
+        T item = heap[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / 4;
+            if (!less(item, heap[parent])) break;
+            heap[i] = heap[parent];
+            i = parent;
+        }
+        heap[i] = item;
+    }
+
+    void siftDown(size_t i) {
+        T item = heap[i];
+        size_t n = heap.size();
+        while (true) {
+            size_t first = 4 * i + 1;
+            if (first >= n) break;
+            size_t best = first;
+            size_t last = std::min(first + 4, n);
+            for (size_t c = first + 1; c < last; ++c)
+                if (less(heap[c], heap[best])) best = c;
+            if (!less(heap[best], item)) break;
+            heap[i] = heap[best];
+            i = best;
+        }
+        heap[i] = item;
+    }
+
+public:
+    explicit HeapOpenList(Less cmp = Less()) : less(cmp) {}
+
+    void reserve(size_t n) { heap.reserve(n); }
+
+    void push(const T& item) {
+        heap.push_back(item);
+        siftUp(heap.size() - 1);
+    }
+
+    const T& top() const { return heap.front(); }
+
+    T pop() {
+        T item = heap.front();
+        heap.front() = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) siftDown(0);
+        return item;
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    size_t bytes() const { return heap.capacity() * sizeof(T); }
+    void clear() { heap.clear(); }
+};
+
+// Open-addressing hash map for duplicate detection: keys, values and occupancy
+// live in three flat arrays, probing is linear and the table doubles at half
+// load. No erase; closed sets only grow during a search.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ClosedSet {
+private:
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    std::vector<uint8_t> used;
+    size_t count = 0;
+    int shift = 58;
+    Hash hasher;
+
+    size_t slotFor(const Key& key) const {
+        // Fibonacci hashing takes the top bits, so weak hashes (identity on
+        // ints) still spread out.
+        size_t mask = keys.size() - 1;
+        size_t i = (size_t)((uint64_t)hasher(key) * 0x9E3779B97F4A7C15ULL >> shift);
+        while (used[i] && !(keys[i] == key)) i = (i + 1) & mask;
+        return i;
+    }
+
+    void grow() {
+        std::vector<Key> oldKeys;
+        std::vector<Value> oldValues;
+        std::vector<uint8_t> oldUsed;
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+        oldUsed.swap(used);
+        size_t capacity = oldKeys.size() * 2;
+        shift--;
+        keys.assign(capacity, Key());
+        values.assign(capacity, Value());
+        used.assign(capacity, 0);
+        for (size_t i = 0; i < oldKeys.size(); ++i) {
+            if (!oldUsed[i]) continue;
+            size_t slot = slotFor(oldKeys[i]);
+            used[slot] = 1;
+            keys[slot] = std::move(oldKeys[i]);
+            values[slot] = std::move(oldValues[i]);
+        }
+    }
+
+public:
+    explicit ClosedSet(size_t expected = 0) {
+        size_t capacity = 64;
+        while (capacity < expected * 2) {
+            capacity *= 2;
+            shift--;
+        }
+        keys.assign(capacity, Key());
+        values.assign(capacity, Value());
+        used.assign(capacity, 0);
+    }
+
+    Value* find(const Key& key) {
+        size_t slot = slotFor(key);
+        return used[slot] ? &values[slot] : nullptr;
+    }
+
+    const Value* find(const Key& key) const {
+        size_t slot = slotFor(key);
+        return used[slot] ? &values[slot] : nullptr;
+    }
+
+    // Returns the stored value and whether the key was new; an existing value is
+    // left untouched.
+    std::pair<Value*, bool> insert(const Key& key, const Value& value) {
+        if ((count + 1) * 2 > keys.size()) grow();
+        size_t slot = slotFor(key);
+        if (used[slot]) return {&values[slot], false};
+        used[slot] = 1;
+        keys[slot] = key;
+        values[slot] = value;
+        count++;
+        return {&values[slot], true};
+    }
+
+    size_t size() const { return count; }
+    size_t bytes() const { return keys.size() * (sizeof(Key) + sizeof(Value) + 1); }
+
+    // What bytes() would be after extra more distinct inserts.
+    size_t bytesAfter(size_t extra) const {
+        size_t capacity = keys.size();
+        while ((count + extra) * 2 > capacity) capacity *= 2;
+        return capacity * (sizeof(Key) + sizeof(Value) + 1);
+    }
+
+    // Empties the set but keeps its capacity; the old keys are released.
+    void clear() {
+        std::fill(keys.begin(), keys.end(), Key());
+        std::fill(used.begin(), used.end(), 0);
+        count = 0;
+    }
+};
+
+// The hash a problem's closed sets use: P::KeyHash if declared, else std::hash.
+template <typename P, typename = void>
+struct KeyHashOf {
+    using type = std::hash<typename P::Key>;
+};
+
+template <typename P>
+struct KeyHashOf<P, std::void_t<typename P::KeyHash>> {
+    using type = typename P::KeyHash;
+};
+
+template <typename P, typename Value>
+using ProblemClosedSet = ClosedSet<typename P::Key, Value, typename KeyHashOf<P>::type>;
+
+// Breadth-first traversal from start; visit(state, depth) runs once per reached
+// state in BFS order. States are marked when enqueued.
+template <typename P, typename Visit>
+long long breadthFirst(const P& problem, const typename P::State& start, Visit visit) {
+    using State = typename P::State;
+    ProblemClosedSet<P, char> seen;
+    FifoQueue<std::pair<State, int>> queue;
+    long long visited = 0;
+    seen.insert(problem.key(start), 1);
+    queue.push({start, 0});
+    while (!queue.empty()) {
+        std::pair<State, int> current = queue.pop();
+        visit(current.first, current.second);
+        visited++;
+        int depth = current.second;
+        problem.successors(current.first, [&](const State& next, int, int) {
+            if (seen.insert(problem.key(next), 1).second) queue.push({next, depth + 1});
+        });
+    }
+    return visited;
+}
+
+// Iterative depth-first traversal: states are marked when popped and children
+// are pushed in reverse so they are tried in successor order, which gives the
+// same preorder as the recursive version. visit(state, depth) gets the depth in
+// the DFS tree.
+template <typename P, typename Visit>
+long long depthFirst(const P& problem, const typename P::State& start, Visit visit) {
+    using State = typename P::State;
+    ProblemClosedSet<P, char> seen;
+    std::vector<std::pair<State, int>> stack{{start, 0}};
+    std::vector<State> children;
+    long long visited = 0;
+    while (!stack.empty()) {
+        std::pair<State, int> current = std::move(stack.back());
+        stack.pop_back();
+        if (!seen.insert(problem.key(current.first), 1).second) continue;
+        visit(current.first, current.second);
+        visited++;
+        children.clear();
+        problem.successors(current.first, [&](const State& next, int, int) {
+            if (!seen.find(problem.key(next))) children.push_back(next);
+        });
+        for (size_t i = children.size(); i-- > 0;) stack.push_back({children[i], current.second + 1});
+    }
+    return visited;
+}
+
+template <typename P>
+class DepthLimitedSearch {
+public:
+    using State = typename P::State;
+
+private:
+    const P& problem;
+    std::unordered_set<typename P::Key, typename KeyHashOf<P>::type> onPath;
+    std::vector<State> path;
+    long long expanded = 0;
+
+    bool dive(const State& state, int limit) {
+        path.push_back(state);
+        if (problem.isGoal(state)) return true;
+        if (limit > 0) {
+            expanded++;
+            onPath.insert(problem.key(state));
+            bool found = false;
+            problem.successors(state, [&](const State& next, int, int) {
+                if (!found && !onPath.count(problem.key(next))) found = dive(next, limit - 1);
+            });
+            onPath.erase(problem.key(state));
+            if (found) return true;
+        }
+        path.pop_back();
+        return false;
+    }
+
+public:
+    explicit DepthLimitedSearch(const P& p) : problem(p) {}
+
+    // Path from start to the first goal within limit edges, or empty. Only
+    // states on the current path count as visited, so every path up to the
+    // limit is tried.
+    std::vector<State> run(const State& start, int limit) {
+        onPath.clear();
+        path.clear();
+        expanded = 0;
+        if (!dive(start, limit)) path.clear();
+        return path;
+    }
+
+    // Runs depth limits 0 .. maxDepth in turn; onDepth(limit) is called before
+    // each iteration.
+    template <typename OnDepth>
+    std::vector<State> iterativeDeepening(const State& start, int maxDepth, OnDepth onDepth) {
+        long long total = 0;
+        for (int depth = 0; depth <= maxDepth; depth++) {
+            onDepth(depth);
+            std::vector<State> result = run(start, depth);
+            total += expanded;
+            if (!result.empty()) {
+                expanded = total;
+                return result;
+            }
+        }
+        expanded = total;
+        return {};
+    }
+
+    long long nodesExpanded() const { return expanded; }
+};
+
+template <typename State>
+struct SearchNode {
+    State state;
+    int parent;
+    int action;
+    int g;
+    int h;
+};
+
+template <typename State>
+struct SearchResult {
+    bool found = false;
+    bool truncated = false;      // stopped by the expansion limit
+    int cost = 0;
+    std::vector<State> path;     // start .. goal
+    std::vector<int> actions;    // one per edge of path
+    long long expanded = 0;
+    long long generated = 0;
+    double elapsedMs = 0;
+    size_t peakBytes = 0;
+};
+
+struct BestFirstOptions {
+    double gWeight = 1;          // A*: 1, greedy best-first: 0
+    double hWeight = 1;          // weighted A*: > 1
+    long long maxExpansions = LLONG_MAX;
+};
+
+struct NullObserver {
+    template <typename Node> void expanded(const Node&, int) {}
+    template <typename Node> void generated(const Node&, int) {}
+};
+
+// Best-first search on f = gWeight * g + hWeight * h. Nodes go into an arena and
+// are referred to by index; the closed set keeps the best g seen per key, so a
+// state is only re-queued when reached more cheaply and stale heap entries are
+// dropped on pop. Ties on f go to the larger g, i.e. deeper nodes first.
+template <typename P>
+class BestFirstSearch {
+public:
+    using State = typename P::State;
+    using Node = SearchNode<State>;
+
+private:
+    struct Entry {
+        double f;
+        int g;
+        int node;
+
+        bool operator<(const Entry& other) const {
+            if (f != other.f) return f < other.f;
+            if (g != other.g) return g > other.g;
+            return node > other.node;
+        }
+    };
+
+    const P& problem;
+    Arena<Node> nodes;
+
+public:
+    explicit BestFirstSearch(const P& p) : problem(p) {}
+
+    const Node& node(int index) const { return nodes[index]; }
+
+    // Actions on the path from the start to node index, in order.
+    std::vector<int> actionsTo(int index) const {
+        std::vector<int> actions;
+        for (int i = index; nodes[i].parent != -1; i = nodes[i].parent) actions.push_back(nodes[i].action);
+        std::reverse(actions.begin(), actions.end());
+        return actions;
+    }
+
+    template <typename Observer = NullObserver>
+    SearchResult<State> run(const State& start, const BestFirstOptions& options = BestFirstOptions(),
+                            Observer&& observer = Observer()) {
+        Stopwatch timer;
+        SearchResult<State> result;
+        nodes.clear();
+        HeapOpenList<Entry> open;
+        ProblemClosedSet<P, int> bestG;
+
+        auto priority = [&](int g, int h) { return options.gWeight * g + options.hWeight * h; };
+
+        int root = (int)nodes.allocate();
+        nodes[root] = Node{start, -1, -1, 0, problem.heuristic(start)};
+        bestG.insert(problem.key(start), 0);
+        open.push({priority(0, nodes[root].h), 0, root});
+        size_t peakOpen = 1;
+
+        while (!open.empty()) {
+            Entry top = open.pop();
+            const Node& current = nodes[top.node];
+            if (*bestG.find(problem.key(current.state)) < current.g) continue; // stale
+
+            if (problem.isGoal(current.state)) {
+                result.found = true;
+                result.cost = current.g;
+                for (int i = top.node; i != -1; i = nodes[i].parent) result.path.push_back(nodes[i].state);
+                std::reverse(result.path.begin(), result.path.end());
+                result.actions = actionsTo(top.node);
+                break;
+            }
+            if (result.expanded >= options.maxExpansions) {
+                result.truncated = true;
+                break;
+            }
+
+            result.expanded++;
+            observer.expanded(current, top.node);
+            int parent = top.node;
+            int parentG = current.g;
+            problem.successors(current.state, [&](const State& next, int cost, int action) {
+                int g = parentG + cost;
+                auto slot = bestG.insert(problem.key(next), g);
+                if (!slot.second) {
+                    if (*slot.first <= g) return;
+                    *slot.first = g;
+                }
+                int child = (int)nodes.allocate();
+                nodes[child] = Node{next, parent, action, g, problem.heuristic(next)};
+                open.push({priority(g, nodes[child].h), g, child});
+                result.generated++;
+                observer.generated(nodes[child], child);
+            });
+            peakOpen = std::max(peakOpen, open.size());
+        }
+
+        result.peakBytes = nodes.bytes() + bestG.bytes() + peakOpen * sizeof(Entry);
+        result.elapsedMs = timer.elapsedMs();
+        return result;
+    }
+};
+
+struct BeamOptions {
+    int width = 1000;                    // states kept per depth layer
+    size_t maxBytes = size_t(256) << 20; // cap on the search's own storage
+    int maxDepth = INT_MAX;
+};
+
+// Heap storage a state or key owns beyond its sizeof, for memory-capped
+// searches: P::heapBytes(x) when the problem declares it (boards in vectors,
+// string keys), zero for flat types.
+template <typename P, typename T, typename = void>
+struct HasHeapBytes : std::false_type {};
+
+template <typename P, typename T>
+struct HasHeapBytes<P, T, std::void_t<decltype(std::declval<const P&>().heapBytes(std::declval<const T&>()))>>
+    : std::true_type {};
+
+template <typename P, typename T>
+size_t heapBytesOf(const P& problem, const T& x) {
+    if constexpr (HasHeapBytes<P, T>::value)
+        return problem.heapBytes(x);
+    else
+        return 0;
+}
+
+// Beam search: breadth-first by depth layer, but only the width children with
+// the lowest h (ties to the lower g) survive each layer. Children are
+// deduplicated within their layer and against every state kept so far, and kept
+// states go into an arena so the path can be recovered. The search tracks its
+// node arena, closed sets and candidate buffer, including the heap storage of
+// states and keys the problem reports through heapBytes() and the transient
+// double allocation while a table grows. Before each allocation it checks that
+// the total stays within maxBytes, and stops short (truncated) if not.
+// Fast and memory-bounded but incomplete: the beam can drop the only route to
+// the goal, in which case it runs dry without a solution. The observer sees each
+// expanded beam node and each child kept for the next layer.
+template <typename P>
+class BeamSearch {
+public:
+    using State = typename P::State;
+    using Node = SearchNode<State>;
+
+private:
+    const P& problem;
+    Arena<Node> nodes;
+
+    // Extra bytes a closed set needs while inserting extra keys: when it grows,
+    // the old and new tables are briefly both alive.
+    template <typename Set>
+    static size_t growthBytes(const Set& set, size_t extra) {
+        size_t after = set.bytesAfter(extra);
+        return after > set.bytes() ? after : 0;
+    }
+
+public:
+    explicit BeamSearch(const P& p) : problem(p) {}
+
+    const Node& node(int index) const { return nodes[index]; }
+
+    std::vector<int> actionsTo(int index) const {
+        std::vector<int> actions;
+        for (int i = index; nodes[i].parent != -1; i = nodes[i].parent) actions.push_back(nodes[i].action);
+        std::reverse(actions.begin(), actions.end());
+        return actions;
+    }
+
+    template <typename Observer = NullObserver>
+    SearchResult<State> run(const State& start, const BeamOptions& options = BeamOptions(),
+                            Observer&& observer = Observer()) {
+        Stopwatch timer;
+        SearchResult<State> result;
+        nodes.clear();
+        ProblemClosedSet<P, char> kept;
+        ProblemClosedSet<P, int> layerIndex; // key -> candidate
+        std::vector<Node> candidates;
+        size_t width = std::max(1, options.width);
+        size_t peakBytes = 0;
+        // Heap bytes behind the stored states and keys.
+        size_t nodeHeap = 0, keptHeap = 0, layerKeyHeap = 0, candidateHeap = 0;
+
+        auto usedBytes = [&]() {
+            return nodes.bytes() + kept.bytes() + layerIndex.bytes() + candidates.capacity() * sizeof(Node) +
+                   nodeHeap + keptHeap + layerKeyHeap + candidateHeap;
+        };
+
+        int goal = -1;
+        std::vector<int> beam{(int)nodes.allocate()};
+        nodes[beam[0]] = Node{start, -1, -1, 0, problem.heuristic(start)};
+        nodeHeap += heapBytesOf(problem, start);
+        typename P::Key startKey = problem.key(start);
+        keptHeap += heapBytesOf(problem, startKey);
+        kept.insert(startKey, 1);
+        if (problem.isGoal(start)) goal = beam[0];
+
+        for (int depth = 0; goal == -1 && !beam.empty(); ++depth) {
+            if (depth >= options.maxDepth) {
+                result.truncated = true;
+                break;
+            }
+
+            // Children of the whole beam, deduplicated.
+            candidates.clear();
+            layerIndex.clear();
+            candidateHeap = layerKeyHeap = 0;
+            bool outOfMemory = false;
+            for (int parent : beam) {
+                if (outOfMemory) break;
+                result.expanded++;
+                observer.expanded(nodes[parent], parent);
+                int parentG = nodes[parent].g;
+                problem.successors(nodes[parent].state, [&](const State& next, int cost, int action) {
+                    if (outOfMemory) return;
+                    typename P::Key key = problem.key(next);
+                    if (kept.find(key)) return;
+                    int g = parentG + cost;
+                    if (int* seen = layerIndex.find(key)) {
+                        Node& other = candidates[*seen];
+                        if (g < other.g) {
+                            candidateHeap -= heapBytesOf(problem, other.state);
+                            other = Node{next, parent, action, g, other.h};
+                            candidateHeap += heapBytesOf(problem, other.state);
+                        }
+                        return;
+                    }
+                    size_t keyHeap = heapBytesOf(problem, key), stateHeap = heapBytesOf(problem, next);
+                    size_t growth = keyHeap + stateHeap + growthBytes(layerIndex, 1);
+                    size_t newCapacity = 0;
+                    if (candidates.size() == candidates.capacity()) {
+                        newCapacity = std::max<size_t>(64, candidates.capacity() * 2);
+                        growth += newCapacity * sizeof(Node); // old buffer lives until the move
+                    }
+                    if (usedBytes() + growth > options.maxBytes) {
+                        outOfMemory = true;
+                        return;
+                    }
+                    if (newCapacity) candidates.reserve(newCapacity);
+                    layerIndex.insert(key, (int)candidates.size());
+                    layerKeyHeap += keyHeap;
+                    candidates.push_back(Node{next, parent, action, g, problem.heuristic(next)});
+                    candidateHeap += stateHeap;
+                    result.generated++;
+                });
+            }
+            peakBytes = std::max(peakBytes, usedBytes());
+            if (outOfMemory) {
+                result.truncated = true;
+                break;
+            }
+
+            // A goal anywhere in the layer ends the search, whatever its h.
+            int goalCandidate = -1;
+            for (size_t i = 0; i < candidates.size(); ++i)
+                if (problem.isGoal(candidates[i].state) &&
+                    (goalCandidate == -1 || candidates[i].g < candidates[goalCandidate].g))
+                    goalCandidate = (int)i;
+            if (goalCandidate != -1) {
+                std::swap(candidates[0], candidates[goalCandidate]);
+                candidates.resize(1);
+            } else if (candidates.size() > width) {
+                std::nth_element(candidates.begin(), candidates.begin() + width, candidates.end(),
+                                 [](const Node& a, const Node& b) { return a.h != b.h ? a.h < b.h : a.g < b.g; });
+                candidates.resize(width);
+            }
+            candidateHeap = 0;
+            size_t newKeyHeap = 0;
+            for (const Node& c : candidates) {
+                candidateHeap += heapBytesOf(problem, c.state);
+                newKeyHeap += heapBytesOf(problem, problem.key(c.state));
+            }
+
+            size_t growth = nodes.bytesAfter(candidates.size()) - nodes.bytes() +
+                            growthBytes(kept, candidates.size()) + newKeyHeap;
+            if (usedBytes() + growth > options.maxBytes) {
+                result.truncated = true;
+                break;
+            }
+            beam.clear();
+            for (Node& c : candidates) {
+                typename P::Key key = problem.key(c.state);
+                int i = (int)nodes.allocate();
+                nodes[i] = std::move(c); // the state's storage moves with it
+                kept.insert(key, 1);
+                beam.push_back(i);
+                observer.generated(nodes[i], i);
+            }
+            nodeHeap += candidateHeap;
+            keptHeap += newKeyHeap;
+            candidateHeap = 0;
+            if (goalCandidate != -1) goal = beam[0];
+            peakBytes = std::max(peakBytes, usedBytes());
+        }
+
+        if (goal != -1) {
+            result.found = true;
+            result.cost = nodes[goal].g;
+            for (int i = goal; i != -1; i = nodes[i].parent) result.path.push_back(nodes[i].state);
+            std::reverse(result.path.begin(), result.path.end());
+            result.actions = actionsTo(goal);
+        }
+        result.peakBytes = std::max(peakBytes, usedBytes());
+        result.elapsedMs = timer.elapsedMs();
+        return result;
+    }
+};
+
+struct AnytimeOptions {
+    double initialWeight = 3;    // first pass runs on f = g + weight * h
+    double weightStep = 0.5;     // weight drops by this much per pass, down to 1
+    double timeLimitMs = 1e300;
+    long long maxExpansions = LLONG_MAX;
+};
+
+// One improved solution from an anytime search. bound is the proven ratio of
+// cost to the optimal cost; 1 means optimal.
+struct AnytimeSolution {
+    double weight;
+    double bound;
+    int cost;
+    std::vector<int> actions;
+    long long expanded;
+    double elapsedMs;
+};
+
+// Anytime Repairing A* (Likhachev, Gordon and Thrun). Passes of weighted A* run
+// with falling weights over one shared search graph: each state has a single
+// node holding its best g, and a state improved after its expansion in the
+// current pass waits in an inconsistent list instead of being expanded again.
+// When a pass ends, the weight drops, the inconsistent states rejoin the open
+// list under the new priorities, and the closed marks are cleared, so every pass
+// resumes from the last one's work rather than starting over. A pass stops as
+// soon as no open node can beat the incumbent's cost. After each pass the
+// incumbent is proven within
+//     min(weight, cost / min over open and inconsistent states of (g + h))
+// of optimal, and that bound is reported to the caller along with the solution.
+// The search stops when a pass at weight 1 finishes (optimal), or when the
+// expansion or time budget runs out, keeping the best solution so far.
+template <typename P>
+class AnytimeAStar {
+public:
+    using State = typename P::State;
+    using Node = SearchNode<State>;
+
+private:
+    struct Entry {
+        double f;
+        int g;
+        int node;
+
+        bool operator<(const Entry& other) const {
+            if (f != other.f) return f < other.f;
+            if (g != other.g) return g > other.g;
+            return node > other.node;
+        }
+    };
+
+    const P& problem;
+    Arena<Node> nodes;
+    std::vector<int> closedInPass;   // pass number that last expanded the node
+    std::vector<uint8_t> status;     // OPEN / INCONS / neither
+
+    enum : uint8_t { NONE = 0, OPEN = 1, INCONS = 2 };
+
+    // Cost of the path to index, from the edge costs the problem emits.
+    int pathCost(int index) const {
+        int cost = 0;
+        for (int i = index; nodes[i].parent != -1; i = nodes[i].parent) {
+            int action = nodes[i].action, edge = 0;
+            problem.successors(nodes[nodes[i].parent].state, [&](const State&, int c, int a) {
+                if (a == action) edge = c;
+            });
+            cost += edge;
+        }
+        return cost;
+    }
+
+public:
+    explicit AnytimeAStar(const P& p) : problem(p) {}
+
+    const Node& node(int index) const { return nodes[index]; }
+
+    std::vector<int> actionsTo(int index) const {
+        std::vector<int> actions;
+        for (int i = index; nodes[i].parent != -1; i = nodes[i].parent) actions.push_back(nodes[i].action);
+        std::reverse(actions.begin(), actions.end());
+        return actions;
+    }
+
+    // report(const AnytimeSolution&) runs once per improved solution. The result
+    // holds the best solution; truncated means the budget ran out before the
+    // solution was proven optimal.
+    template <typename Report>
+    SearchResult<State> run(const State& start, const AnytimeOptions& options, Report&& report) {
+        Stopwatch timer;
+        SearchResult<State> result;
+        nodes.clear();
+        closedInPass.clear();
+        status.clear();
+        ProblemClosedSet<P, int> nodeOf;
+        HeapOpenList<Entry> open;
+
+        double weight = std::max(1.0, options.initialWeight);
+        auto priority = [&](int i) { return nodes[i].g + weight * nodes[i].h; };
+        auto addNode = [&](const Node& n) {
+            int i = (int)nodes.allocate();
+            nodes[i] = n;
+            closedInPass.push_back(-1);
+            status.push_back(NONE);
+            return i;
+        };
+
+        int root = addNode(Node{start, -1, -1, 0, problem.heuristic(start)});
+        nodeOf.insert(problem.key(start), root);
+        open.push({priority(root), 0, root});
+        status[root] = OPEN;
+
+        int incumbent = problem.isGoal(start) ? root : -1;
+        double lowerBound = nodes[root].h; // on the optimal cost; h is assumed admissible
+        double reportedBound = std::numeric_limits<double>::infinity();
+        size_t peakOpen = 1;
+        bool outOfBudget = false;
+
+        // Publishes the incumbent if it is cheaper or better bounded than the
+        // last solution reported.
+        auto publish = [&]() {
+            int cost = pathCost(incumbent);
+            double bound = cost == 0 ? 1.0
+                           : lowerBound > 0 ? std::max(1.0, cost / lowerBound)
+                                            : std::numeric_limits<double>::infinity();
+            if (result.found && cost >= result.cost && bound >= reportedBound) return;
+            reportedBound = bound;
+            result.found = true;
+            result.cost = cost;
+            result.actions = actionsTo(incumbent);
+            result.path.clear();
+            for (int i = incumbent; i != -1; i = nodes[i].parent) result.path.push_back(nodes[i].state);
+            std::reverse(result.path.begin(), result.path.end());
+            report(AnytimeSolution{weight, bound, cost, result.actions, result.expanded, timer.elapsedMs()});
+        };
+
+        for (int pass = 0;; ++pass) {
+            // Improve the incumbent under the current weight.
+            while (!open.empty()) {
+                Entry top = open.top();
+                if (status[top.node] != OPEN || nodes[top.node].g != top.g) {
+                    open.pop(); // stale
+                    continue;
+                }
+                if (incumbent != -1 && nodes[incumbent].g <= top.f) break;
+                if (result.expanded >= options.maxExpansions ||
+                    ((result.expanded & 255) == 0 && timer.elapsedMs() >= options.timeLimitMs)) {
+                    outOfBudget = true;
+                    break;
+                }
+                open.pop();
+                status[top.node] = NONE;
+                closedInPass[top.node] = pass;
+                result.expanded++;
+
+                int parent = top.node;
+                int parentG = nodes[parent].g;
+                problem.successors(nodes[parent].state, [&](const State& next, int cost, int action) {
+                    int g = parentG + cost;
+                    auto slot = nodeOf.insert(problem.key(next), -1);
+                    int child;
+                    if (slot.second) {
+                        child = addNode(Node{next, parent, action, g, problem.heuristic(next)});
+                        *slot.first = child;
+                    } else {
+                        child = *slot.first;
+                        if (nodes[child].g <= g) return;
+                        nodes[child].parent = parent;
+                        nodes[child].action = action;
+                        nodes[child].g = g;
+                    }
+                    result.generated++;
+                    if (problem.isGoal(next) && (incumbent == -1 || g < nodes[incumbent].g)) incumbent = child;
+                    if (closedInPass[child] == pass) {
+                        status[child] = INCONS;
+                    } else {
+                        status[child] = OPEN;
+                        open.push({priority(child), g, child});
+                    }
+                });
+                peakOpen = std::max(peakOpen, open.size());
+            }
+
+            // A cut-short pass proves nothing new, but a solution it found is
+            // still covered by the last pass's lower bound.
+            if (outOfBudget) {
+                if (incumbent != -1) publish();
+                break;
+            }
+            if (incumbent == -1) break; // open ran dry: no solution
+
+            // The incumbent is within weight of optimal, and the optimal path
+            // runs through some open or inconsistent state.
+            double frontier = nodes[incumbent].g;
+            for (size_t i = 0; i < nodes.size(); ++i)
+                if (status[i] != NONE) frontier = std::min(frontier, (double)nodes[i].g + nodes[i].h);
+            lowerBound = std::max({lowerBound, nodes[incumbent].g / weight, frontier});
+            publish();
+
+            if (weight <= 1 || reportedBound <= 1) break;
+
+            // Next pass: lower the weight, re-key open and inconsistent states.
+            weight = std::max(1.0, weight - options.weightStep);
+            open.clear();
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (status[i] == NONE) continue;
+                status[i] = OPEN;
+                open.push({priority((int)i), nodes[i].g, (int)i});
+            }
+        }
+
+        result.truncated = outOfBudget && reportedBound > 1;
+        result.peakBytes = nodes.bytes() + nodeOf.bytes() + peakOpen * sizeof(Entry) +
+                           closedInPass.capacity() * sizeof(int) + status.capacity();
+        result.elapsedMs = timer.elapsedMs();
+        return result;
+    }
+};
+
+// Single-source shortest paths over a growable digraph with non-negative integer
+// weights, kept current under batches of arc insertions and deletions in the
+// style of Ramalingam and Reps. A batch first finds the vertices that lost every
+// shortest-path parent, working outward in order of old distance, and resets
+// only those. Their surviving in-neighbours and the inserted arcs then seed one
+// Dijkstra pass, which stops spreading wherever nothing improves. The work
+// follows the vertices whose distance changes, not the graph size. Undirected
+// graphs pass every edge as two arcs; unit weights make the distances BFS levels.
+class DynamicShortestPaths {
+public:
+    static constexpr long long UNREACHABLE = LLONG_MAX / 4;
+
+    struct Update {
+        int u, v, w;      // w is ignored for deletions
+        bool insert;      // false: delete every arc u -> v
+    };
+
+private:
+    struct Arc {
+        int to;
+        int w;
+    };
+
+    int source;
+    std::vector<std::vector<Arc>> out, in;
+    std::vector<long long> dist;
+    std::vector<char> affected;
+    HeapOpenList<std::pair<long long, int>> heap;
+
+    static int removeArcs(std::vector<Arc>& arcs, int to) {
+        int removed = 0;
+        for (size_t i = 0; i < arcs.size();) {
+            if (arcs[i].to == to) {
+                arcs[i] = arcs.back();
+                arcs.pop_back();
+                removed++;
+            } else {
+                i++;
+            }
+        }
+        return removed;
+    }
+
+    long long settle() {
+        long long settled = 0;
+        while (!heap.empty()) {
+            std::pair<long long, int> top = heap.pop();
+            int x = top.second;
+            if (top.first != dist[x]) continue;
+            settled++;
+            for (const Arc& a : out[x]) {
+                if (top.first + a.w < dist[a.to]) {
+                    dist[a.to] = top.first + a.w;
+                    heap.push({dist[a.to], a.to});
+                }
+            }
+        }
+        return settled;
+    }
+
+public:
+    DynamicShortestPaths(int vertices, int src)
+        : source(src), out(vertices), in(vertices), dist(vertices, UNREACHABLE), affected(vertices, 0) {
+        dist[source] = 0;
+    }
+
+    int addVertex() {
+        out.emplace_back();
+        in.emplace_back();
+        dist.push_back(UNREACHABLE);
+        affected.push_back(0);
+        return (int)out.size() - 1;
+    }
+
+    int vertexCount() const { return (int)out.size(); }
+
+    // Adds an arc without repairing distances; call recompute() after bulk loading.
+    void addArc(int u, int v, int w) {
+        out[u].push_back({v, w});
+        in[v].push_back({u, w});
+    }
+
+    bool hasArc(int u, int v, int w) const {
+        for (const Arc& a : out[u])
+            if (a.to == v && a.w == w) return true;
+        return false;
+    }
+
+    template <typename Fn>
+    void forEachArc(Fn fn) const {
+        for (int u = 0; u < (int)out.size(); ++u)
+            for (const Arc& a : out[u]) fn(u, a.to, a.w);
+    }
+
+    void recompute() {
+        std::fill(dist.begin(), dist.end(), UNREACHABLE);
+        dist[source] = 0;
+        heap.clear();
+        heap.push({0, source});
+        settle();
+    }
+
+    // Applies the batch and repairs the distances. Returns the number of distinct
+    // vertices the repair reset or settled.
+    long long apply(const std::vector<Update>& batch) {
+        HeapOpenList<std::pair<long long, int>> candidates;
+        for (const Update& up : batch) {
+            if (up.insert) {
+                addArc(up.u, up.v, up.w);
+                continue;
+            }
+            if (!removeArcs(out[up.u], up.v)) continue;
+            removeArcs(in[up.v], up.u);
+            if (dist[up.u] != UNREACHABLE && dist[up.v] != UNREACHABLE) candidates.push({dist[up.v], up.v});
+        }
+
+        // A candidate is affected when no unaffected in-neighbour still gives it
+        // its old distance over a positive-weight arc. Such a neighbour is strictly
+        // closer, so in old-distance order its own status is already final.
+        // Zero-weight arcs could support each other in a cycle, so they are not
+        // trusted here; the vertex is reset and the reseeding below restores it.
+        // Becoming affected re-queues the tight out-neighbours, even ones already
+        // checked.
+        std::vector<int> lost;
+        while (!candidates.empty()) {
+            int x = candidates.pop().second;
+            if (affected[x] || x == source) continue;
+            bool supported = false;
+            for (const Arc& a : in[x]) {
+                if (a.w > 0 && !affected[a.to] && dist[a.to] != UNREACHABLE && dist[a.to] + a.w == dist[x]) {
+                    supported = true;
+                    break;
+                }
+            }
+            if (supported) continue;
+            affected[x] = 1;
+            lost.push_back(x);
+            for (const Arc& a : out[x])
+                if (!affected[a.to] && dist[x] + a.w == dist[a.to]) candidates.push({dist[a.to], a.to});
+        }
+
+        heap.clear();
+        for (int x : lost) dist[x] = UNREACHABLE;
+        for (int x : lost) {
+            for (const Arc& a : in[x]) {
+                if (!affected[a.to] && dist[a.to] != UNREACHABLE && dist[a.to] + a.w < dist[x])
+                    dist[x] = dist[a.to] + a.w;
+            }
+            if (dist[x] != UNREACHABLE) heap.push({dist[x], x});
+        }
+        for (int x : lost) affected[x] = 0;
+
+        for (const Update& up : batch) {
+            if (up.insert && dist[up.u] != UNREACHABLE && dist[up.u] + up.w < dist[up.v] && hasArc(up.u, up.v, up.w)) {
+                dist[up.v] = dist[up.u] + up.w;
+                heap.push({dist[up.v], up.v});
+            }
+        }
+        long long touched = (long long)lost.size() + settle();
+        for (int x : lost)
+            if (dist[x] != UNREACHABLE) touched--; // reset and then settled again
+        return touched;
+    }
+
+    const std::vector<long long>& distances() const { return dist; }
+};
+
+} // namespace search
+
+#endif